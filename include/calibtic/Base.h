@@ -6,11 +6,21 @@
 
 namespace calibtic {
 
+namespace trafo {
+class Pool;
+} // trafo
+
 class Base
 {
 public:
 	virtual ~Base();
 
+#ifndef PYPLUSPLUS
+	/// replaces all transformations by their instances in @param pool, see
+	/// trafo::Pool
+	virtual void intern(trafo::Pool& pool);
+#endif // PYPLUSPLUS
+
 #ifndef PYPLUSPLUS
 	// operator== needs to be removed for code generation, otherwise
 	// #!&($-PY++ will emit code, which tries to instantiate this
@@ -60,6 +60,10 @@ public:
 
 	virtual void copy(Calibration const&);
 
+#ifndef PYPLUSPLUS
+	virtual void intern(trafo::Pool& pool);
+#endif // PYPLUSPLUS
+
 protected:
 	template<typename InputIt, typename OutputIt>
 	void apply(
@@ -77,6 +81,22 @@ protected:
 	                     trafo_t::OutsideDomainBehavior outside_domain_behavior =
 	                         trafo_t::CLIP) const;
 
+#ifndef PYPLUSPLUS
+	/// applies the transformation at @param offset to the @param n values at
+	/// @param in, @param out may be identical to @param in
+	void applyMany(float_type const* in, float_type* out, size_t n,
+	               key_type const offset = 0,
+	               trafo_t::OutsideDomainBehavior outside_domain_behavior =
+	                   trafo_t::CLIP) const;
+
+	/// applies the transformation at @param offset in reverse to the @param n
+	/// values at @param in, @param out may be identical to @param in
+	void reverseApplyMany(float_type const* in, float_type* out, size_t n,
+	                      key_type const offset = 0,
+	                      trafo_t::OutsideDomainBehavior outside_domain_behavior =
+	                          trafo_t::CLIP) const;
+#endif // PYPLUSPLUS
+
 	std::vector<value_type> mTrafo;
 
 private:
@@ -122,7 +142,8 @@ void Calibration::applyOne(
     trafo_t::OutsideDomainBehavior outside_domain_behavior) const {
 	assert(mTrafo.size() > offset);
 
-	const_value_type val = mTrafo[offset];
+	// no copy, the reference count would be shared by all threads
+	value_type const& val = mTrafo[offset];
 	handleUninitialized(static_cast<bool>(val));
 
 	out = val->apply(in, outside_domain_behavior);
@@ -132,7 +153,7 @@ template <typename In, typename Out>
 void Calibration::reverseApplyOne(
     In const& in, Out& out, key_type const offset,
     trafo_t::OutsideDomainBehavior outside_domain_behavior) const {
-	const_value_type val = mTrafo.at(offset);
+	value_type const& val = mTrafo.at(offset);
 	handleUninitialized(static_cast<bool>(val));
 
 	out = val->reverseApply(in, outside_domain_behavior);
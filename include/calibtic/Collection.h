@@ -1,6 +1,7 @@
 #pragma once
 
 #include <map>
+#include <vector>
 #include <boost/serialization/serialization.hpp>
 #include <boost/serialization/nvp.hpp>
 #include <boost/serialization/map.hpp>
@@ -51,6 +52,11 @@ public:
 
 	size_type size() const;
 
+#ifndef PYPLUSPLUS
+	/// keys of all entries in ascending order
+	std::vector<key_type> keys() const;
+#endif // PYPLUSPLUS
+
 	virtual bool operator== (Base const& rhs) const;
 	bool operator== (Collection const& rhs) const;
 
@@ -62,6 +68,10 @@ public:
 
 	virtual void copy(Collection const& rhs);
 
+#ifndef PYPLUSPLUS
+	virtual void intern(trafo::Pool& pool);
+#endif // PYPLUSPLUS
+
 protected:
 	map_type mBases;
 
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <ostream>
+#include <boost/shared_ptr.hpp>
+
+#include "calibtic/config.h"
+#include "calibtic/Calibration.h"
+#include "calibtic/trafo/Transformation.h"
+
+namespace calibtic {
+
+/// Frozen, read-only copy of one or more Calibrations.
+///
+/// Kind, domain and coefficients of all transformations are stored in
+/// contiguous arrays and evaluated with a switch instead of a virtual call.
+/// Constant, Polynomial and NegativePowersPolynomial are copied inline, later
+/// changes to them are not reflected. All other transformations and
+/// reverseApply use the original transformations, which are kept alive.
+class CompactCalibration
+{
+public:
+	typedef Calibration::trafo_t trafo_t;
+	typedef Calibration::key_type key_type;
+	typedef Calibration::size_type size_type;
+
+	CompactCalibration();
+	explicit CompactCalibration(Calibration const& calib);
+
+	/// appends a copy of @param calib, returns its index
+	size_type push_back(Calibration const& calib);
+
+	/// number of stored Calibrations
+	size_type size() const;
+
+	/// number of transformations of the Calibration at @param index
+	size_type size(size_type const index) const;
+
+	bool exists(size_type const index, key_type const key) const;
+
+	/// same as applying the transformation at @param key of the Calibration at
+	/// @param index
+	float_type apply(size_type const index, key_type const key,
+	                 float_type const in,
+	                 trafo_t::OutsideDomainBehavior outside_domain_behavior =
+	                     trafo_t::CLIP) const;
+
+	/// evaluated by the original transformation
+	float_type reverseApply(size_type const index, key_type const key,
+	                        float_type const in,
+	                        trafo_t::OutsideDomainBehavior outside_domain_behavior =
+	                            trafo_t::CLIP) const;
+
+#ifndef PYPLUSPLUS
+	/// batch version of apply, @param out may be identical to @param in
+	void apply(size_type const index, key_type const key,
+	           float_type const* in, float_type* out, size_t n,
+	           trafo_t::OutsideDomainBehavior outside_domain_behavior =
+	               trafo_t::CLIP) const;
+#endif // PYPLUSPLUS
+
+	/// bytes used by the inline representation
+	size_t memory() const;
+
+	std::ostream& operator<< (std::ostream& os) const;
+
+	// factory function for Py++
+	static
+	boost::shared_ptr<CompactCalibration> create(Calibration const& calib);
+
+private:
+	enum Kind : uint8_t {
+		UNINITIALIZED,
+		CONSTANT,
+		POLYNOMIAL,
+		NEGATIVE_POWERS,
+		FALLBACK
+	};
+
+	/// position of @param key of Calibration @param index in the entry arrays
+	size_t entry(size_type const index, key_type const key) const;
+
+	float_type respectDomain(size_t const entry, float_type const in,
+	                         trafo_t::OutsideDomainBehavior outside_domain_behavior) const;
+	void respectDomain(size_t const entry, float_type const* in, float_type* out,
+	                   size_t n,
+	                   trafo_t::OutsideDomainBehavior outside_domain_behavior) const;
+
+	/// first entry of each Calibration, the last element is the end
+	std::vector<uint32_t> mBegin;
+
+	/// one element per entry
+	std::vector<Kind> mKind;
+	std::vector<float_type> mLower;
+	std::vector<float_type> mUpper;
+	/// first coefficient in mCoefficients and number of coefficients
+	std::vector<uint32_t> mOffset;
+	std::vector<uint32_t> mCount;
+
+	std::vector<float_type> mCoefficients;
+
+	/// the original transformations, only touched for FALLBACK and reverseApply
+	std::vector<Calibration::const_value_type> mTrafos;
+};
+
+std::ostream& operator<< (std::ostream& os, CompactCalibration const& c);
+
+} // calibtic
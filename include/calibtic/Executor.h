@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <boost/shared_ptr.hpp>
+
+#ifndef PYPLUSPLUS
+#include <functional>
+#endif // PYPLUSPLUS
+
+namespace calibtic {
+
+/// Fixed pool of worker threads for data parallel calibration.
+///
+/// parallel_for splits an index range into chunks which are taken by the
+/// workers and the calling thread. Each index is processed exactly once, so
+/// results written per index do not depend on the number of threads or on
+/// scheduling. Calls from different threads are serialized, nested calls from
+/// within a chunk run in the calling thread.
+class Executor
+{
+public:
+	/// @param threads total number of threads including the caller, 0 uses
+	/// one per hardware thread, 1 runs everything in the calling thread
+	explicit Executor(size_t threads = 0);
+	~Executor();
+
+	/// total number of threads including the caller
+	size_t size() const;
+
+#ifndef PYPLUSPLUS
+	typedef std::function<void(size_t begin, size_t end)> range_function;
+
+	/// calls @param f for consecutive ranges [begin, end) covering [0, n) of
+	/// at most @param grain indices, 0 chooses the grain from the number of
+	/// threads. Returns when all ranges are done. If ranges throw, the
+	/// exception of the first of them is rethrown.
+	void parallel_for(size_t n, range_function const& f, size_t grain = 0);
+#endif // PYPLUSPLUS
+
+	// factory function for Py++
+	static
+	boost::shared_ptr<Executor> create(size_t threads = 0);
+
+private:
+	Executor(Executor const&);
+	Executor& operator=(Executor const&);
+
+	class Impl;
+	boost::shared_ptr<Impl> mImpl;
+};
+
+} // calibtic
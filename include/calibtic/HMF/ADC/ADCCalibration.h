@@ -10,6 +10,8 @@
 #include "calibtic/backend/Backend.h"
 
 #include "calibtic/HMF/ADC/VoltageMeasurement.h"
+#include "calibtic/HMF/ADC/TraceStatistics.h"
+#include "calibtic/HMF/ADC/PolynomialFitter.h"
 
 #include "halco/hicann/v2/external.h"
 #include "hal/ADC/USBSerial.h"
@@ -17,10 +19,15 @@
 #include "pywrap/compat/numpy.hpp"
 #include "pywrap/compat/macros.hpp"
 
+#ifndef PYPLUSPLUS
+#include <functional>
+#endif // PYPLUSPLUS
+
 namespace HMF {
 namespace ADC {
 
 class QuadraticADCCalibration;
+class LUTADCCalibration;
 
 class ADCCalibration :
 	public calibtic::Calibration
@@ -37,10 +44,69 @@ public:
 	pyublas::numpy_vector<float>
 	virtual apply(key_type channel, pyublas::numpy_vector<uint16_t> const& data) const;
 
-	void makePolynomialTrafo(Calibration::key_type offset,
+	/// converts @param data into the caller provided @param out, which is
+	/// resized to the size of @param data. Reusing @param out for several
+	/// traces avoids an allocation per call.
+	void apply(key_type channel, std::vector<uint16_t> const& data,
+	           std::vector<float>& out) const;
+
+	/// converts @param data into the existing float32 array @param out, which
+	/// is written in place and needs at least as many elements as @param data
+	void apply(key_type channel, pyublas::numpy_vector<uint16_t> const& data,
+	           pyublas::numpy_vector<float> out) const;
+
+	/// statistics of the converted @param data accumulated onto @param stats,
+	/// which may be configured with a histogram. The converted trace is not
+	/// kept.
+	TraceStatistics statistics(key_type channel, std::vector<uint16_t> const& data,
+	                           TraceStatistics stats = TraceStatistics()) const;
+
+	TraceStatistics statistics(key_type channel, pyublas::numpy_vector<uint16_t> const& data,
+	                           TraceStatistics stats = TraceStatistics()) const;
+
+#ifndef PYPLUSPLUS
+	/// converts @param n samples from @param data and accumulates them onto
+	/// @param stats, only a small block of converted samples is held at a time
+	void accumulate(key_type channel, uint16_t const* data, size_t n,
+	                TraceStatistics& stats) const;
+
+	/// converts @param n samples from @param data into the caller provided
+	/// buffer @param out, nothing is allocated per call
+	virtual void apply(key_type channel, uint16_t const* data, float* out, size_t n) const;
+
+	/// appends up to @param n samples to the empty @param buffer, leaves it
+	/// empty at the end of the trace. The buffer has room for n samples,
+	/// appending more is rejected without overrunning memory.
+	typedef std::function<void(std::vector<uint16_t>& buffer, size_t n)> source_function;
+	/// receives @param n converted samples
+	typedef std::function<void(float const* buffer, size_t n)> sink_function;
+
+	/// streams a trace that does not fit into memory from @param source to
+	/// @param sink in chunks of at most @param chunk samples. Only one chunk
+	/// of raw and converted samples is held at a time. Returns the number of
+	/// converted samples.
+	size_t applyChunked(key_type channel, source_function const& source,
+	                    sink_function const& sink, size_t chunk = 1 << 16) const;
+#endif // PYPLUSPLUS
+
+	/// fits a polynomial of @param order to @param voltage and uses it for
+	/// channel @param offset, returns the goodness of the fit
+	PolynomialFit makePolynomialTrafo(Calibration::key_type offset,
 		VoltageMeasurement const& voltage,
 		unsigned const order = 2);
 
+	/// fits all channels at once, @param voltages holds the measurement of
+	/// each channel. The calibration is only modified if all fits succeed.
+	std::vector<PolynomialFit> makePolynomialTrafos(
+		std::vector<VoltageMeasurement> const& voltages,
+		unsigned const order = 2);
+
+	/// same as above, @param fitter can be reused for many calibrations
+	std::vector<PolynomialFit> makePolynomialTrafos(
+		std::vector<VoltageMeasurement> const& voltages,
+		unsigned const order,
+		PolynomialFitter& fitter);
+
 	virtual std::ostream& operator<< (std::ostream&) const;
 
 	calibtic::MetaData
@@ -69,6 +135,12 @@ public:
 	boost::shared_ptr<QuadraticADCCalibration> convertToQuadraticADCCalibration(
 		const ADCCalibration & other);
 
+	// Convert to LUTADCCalibration for samples of @param bits resolution,
+	// the transformations are shared with @param other
+	static
+	boost::shared_ptr<LUTADCCalibration> convertToLUTADCCalibration(
+		const ADCCalibration & other, unsigned bits = 16);
+
 	virtual bool isComplete() const;
 
 protected:
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <boost/serialization/serialization.hpp>
+#include <boost/serialization/nvp.hpp>
+
 namespace HMF {
 namespace ADC {
 
@@ -0,0 +1,108 @@
+#pragma once
+#include <array>
+#include <memory>
+#include <vector>
+
+#include <boost/serialization/serialization.hpp>
+#include <boost/serialization/nvp.hpp>
+
+#include <boost/shared_ptr.hpp>
+
+#include "calibtic/HMF/ADC/ADCCalibration.h"
+
+namespace HMF {
+namespace ADC {
+
+/// ADCCalibration that converts samples by table lookup.
+///
+/// For each channel, the transformation is evaluated once for all of the 2^bits
+/// possible samples that lie inside its domain. Converting a trace is then a
+/// single lookup per sample, independent of the transformation, so any
+/// transformation can be used, e.g. polynomials of higher degree than
+/// QuadraticADCCalibration supports. Samples outside of the table, i.e. beyond
+/// the domain or the resolution, are converted by the transformation one by
+/// one, which clips them as ADCCalibration does. Table entries are computed by
+/// the batch version of the transformation and may differ from the results of
+/// ADCCalibration within rounding.
+///
+/// A table is built on the first conversion of its channel and rebuilt after
+/// the transformation of the channel has been replaced, e.g. by reset() or
+/// load(). Transformations modified in place are not detected, call
+/// clearTables() afterwards.
+class LUTADCCalibration :
+	public ADCCalibration
+{
+public:
+	/// @param bits resolution of the samples, tables hold 2^bits voltages
+	explicit LUTADCCalibration(unsigned bits = 16);
+	virtual ~LUTADCCalibration();
+
+	unsigned getBits() const;
+
+	using ADCCalibration::apply;
+
+#ifndef PYPLUSPLUS
+	virtual void apply(key_type channel, uint16_t const* data, float* out, size_t n) const PYPP_OVERRIDE;
+#endif // PYPLUSPLUS
+
+	/// drops the tables of all channels
+	void clearTables();
+
+	virtual std::ostream& operator<< (std::ostream&) const;
+
+	// Py++ factory function
+	static
+	boost::shared_ptr<LUTADCCalibration> create(unsigned bits = 16);
+
+private:
+#ifndef PYPLUSPLUS
+	struct Table
+	{
+		/// the transformation the table was built from, kept alive so that
+		/// its address cannot be reused by a replacement
+		const_value_type trafo;
+		/// sample of the first entry, the lower end of the domain
+		size_t first;
+		std::vector<float> voltages;
+	};
+
+	/// returns the table of @param channel, builds it if the transformation
+	/// has been replaced
+	std::shared_ptr<Table const> table(key_type channel) const;
+
+	static size_t const num_channels = 8;
+
+	/// not serialized, shared between copies since they are never modified
+	mutable std::array<std::shared_ptr<Table const>, num_channels> mTables;
+#endif // PYPLUSPLUS
+
+	unsigned mBits;
+
+	friend class boost::serialization::access;
+	template<typename Archiver>
+	void serialize(Archiver& ar, unsigned int const);
+};
+
+} // ADC
+} // HMF
+
+
+
+// implementation
+namespace HMF {
+namespace ADC {
+
+template<typename Archiver>
+void LUTADCCalibration::serialize(Archiver& ar, unsigned int const)
+{
+	using namespace boost::serialization;
+	ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(ADCCalibration)
+	   & make_nvp("bits", mBits);
+
+	if (Archiver::is_loading::value) {
+		clearTables();
+	}
+}
+
+} // ADC
+} // HMF
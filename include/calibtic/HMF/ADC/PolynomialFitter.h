@@ -0,0 +1,69 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include "calibtic/HMF/ADC/VoltageMeasurement.h"
+
+namespace HMF {
+namespace ADC {
+
+/// result of a weighted polynomial fit
+struct PolynomialFit
+{
+	/// coefficients of x^0, x^1, ...
+	std::vector<double> coefficients;
+
+	/// covariance matrix of the coefficients, row-major
+	std::vector<double> covariance;
+
+	/// weighted sum of squared residuals
+	double chisq;
+
+	/// number of fitted data points
+	size_t points;
+};
+
+/// Weighted least squares fit of polynomials to voltage measurements, the
+/// reference voltage is fitted as function of the measured mean, weighted by
+/// 1/std^2.
+///
+/// The workspace is kept between fits of the same size, so fitting many
+/// channels or boards with one fitter does not allocate per fit.
+class PolynomialFitter
+{
+public:
+	enum Method {
+		GSL,             //!< gsl_multifit_wlinear, most robust
+		NORMAL_EQUATIONS //!< Cholesky solution of the normal equations of
+		                 //!< the rescaled problem, fastest for low orders
+	};
+
+	explicit PolynomialFitter(Method method = GSL);
+	~PolynomialFitter();
+
+	Method getMethod() const;
+
+	PolynomialFit fit(VoltageMeasurement const& voltage, unsigned order = 2);
+
+#ifndef PYPLUSPLUS
+	/// same as above, reuses the vectors of @param result
+	void fit(VoltageMeasurement const& voltage, unsigned order, PolynomialFit& result);
+#endif // PYPLUSPLUS
+
+private:
+	PolynomialFitter(PolynomialFitter const&);
+	PolynomialFitter& operator=(PolynomialFitter const&);
+
+	void fitGSL(VoltageMeasurement const& voltage, size_t n_coeff, PolynomialFit& result);
+	void fitNormalEquations(VoltageMeasurement const& voltage, size_t n_coeff, PolynomialFit& result);
+
+	Method mMethod;
+
+	class Workspace;
+	boost::shared_ptr<Workspace> mWorkspace;
+};
+
+} // ADC
+} // HMF
@@ -6,6 +6,7 @@
 #include <boost/shared_ptr.hpp>
 
 #include "calibtic/Calibration.h"
+#include "calibtic/simd.h"
 #include "calibtic/backend/Backend.h"
 
 #include "calibtic/HMF/ADC/VoltageMeasurement.h"
@@ -40,12 +41,23 @@ public:
 	QuadraticADCCalibration(coefficents_t);
 	virtual ~QuadraticADCCalibration();
 
+	using ADCCalibration::apply;
+
 	std::vector<float>
 	virtual apply(key_type channel, std::vector<uint16_t> const& data) const PYPP_OVERRIDE;
 
 	pyublas::numpy_vector<float>
 	virtual apply(key_type channel, pyublas::numpy_vector<uint16_t> const& data) const PYPP_OVERRIDE;
 
+#ifndef PYPLUSPLUS
+	virtual void apply(key_type channel, uint16_t const* data, float* out, size_t n) const PYPP_OVERRIDE;
+
+	/// same as above, using the given @param kernel. All kernels produce
+	/// bit-identical results.
+	void apply(key_type channel, uint16_t const* data, float* out, size_t n,
+	           calibtic::simd::Kernel kernel) const;
+#endif // PYPLUSPLUS
+
 	virtual std::ostream& operator<< (std::ostream&) const;
 
 	calibtic::MetaData
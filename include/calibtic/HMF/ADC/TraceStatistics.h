@@ -0,0 +1,76 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+#include "calibtic/HMF/ADC/DataPoint.h"
+
+namespace HMF {
+namespace ADC {
+
+/// Running statistics of a converted trace, accumulated in a single pass.
+///
+/// Mean and variance are updated with Welford's algorithm, partial results
+/// (e.g. of chunks converted by different threads) are combined by merge().
+/// Optionally, the values are sorted into a histogram of equally wide bins.
+class TraceStatistics
+{
+public:
+	/// statistics without histogram
+	TraceStatistics();
+
+	/// statistics with a histogram of @param bins bins in [@param lower,
+	/// @param upper), values outside are counted by underflow() and
+	/// overflow(). NaN values are counted as overflow, they also turn mean
+	/// and variance into NaN.
+	TraceStatistics(size_t bins, double lower, double upper);
+
+	void push(double value);
+
+#ifndef PYPLUSPLUS
+	void push(float const* values, size_t n);
+#endif // PYPLUSPLUS
+
+	/// adds the values accumulated by @param other, which has to use the same
+	/// histogram bins
+	void merge(TraceStatistics const& other);
+
+	size_t count() const;
+	double mean() const;
+
+	/// variance normalized by the number of values (like numpy.var)
+	double variance() const;
+	double std() const;
+
+	double min() const;
+	double max() const;
+
+	std::vector<size_t> histogram() const;
+	size_t underflow() const;
+	size_t overflow() const;
+
+	/// lower edge of histogram bin @param bin, upper edge for bin == bins
+	double binEdge(size_t bin) const;
+
+	/// measurement of reference voltage @param ref
+	DataPoint toDataPoint(DataPoint::value_type ref) const;
+
+private:
+	void mergeMoments(size_t count, double mean, double m2, double min, double max);
+	void bin(double value);
+
+	size_t mCount;
+	double mMean;
+	/// sum of squared differences from the mean
+	double mM2;
+	double mMin;
+	double mMax;
+
+	double mLower;
+	double mUpper;
+	std::vector<size_t> mHistogram;
+	size_t mUnderflow;
+	size_t mOverflow;
+};
+
+} // ADC
+} // HMF
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "calibtic/Collection.h"
+#include "calibtic/Executor.h"
 #include "calibtic/HMF/SharedCalibration.h"
 #include "calibtic/HMF/HWNeuronParameter.h"
 
@@ -25,7 +26,27 @@ public:
 
 	HWSharedParameter applySharedCalibration(double v_reset, size_t hw_shared_id) const;
 
+#ifndef PYPLUSPLUS
+	/// calibrates block hw_shared_ids[ii] with v_reset[ii] for all @param n
+	/// blocks and writes the result to out[ii]
+	void applySharedCalibration(
+		double const* v_reset, size_t const* hw_shared_ids, size_t const n,
+		HWSharedParameter* out) const;
+
+	/// same as above, the blocks are distributed over the threads of
+	/// @param executor
+	void applySharedCalibration(
+		double const* v_reset, size_t const* hw_shared_ids, size_t const n,
+		HWSharedParameter* out, calibtic::Executor& executor) const;
+#endif // PYPLUSPLUS
+
 private:
+#ifndef PYPLUSPLUS
+	void _applySharedCalibration(
+		double const* v_reset, size_t const* hw_shared_ids, size_t const n,
+		HWSharedParameter* out, calibtic::Executor* executor) const;
+#endif // PYPLUSPLUS
+
 	friend class boost::serialization::access;
 	template<typename Archiver>
 	void serialize(Archiver& ar, unsigned int const);
@@ -3,6 +3,7 @@
 #include <cmath>
 #include <iostream>
 #include <vector>
+#include "pywrap/compat/macros.hpp"
 #include "calibtic/Collection.h"
 #include "calibtic/HMF/HICANNCollection.h"
 #include "calibtic/HMF/NeuronCollection.h"
@@ -13,6 +14,10 @@
 #include "calibtic/HMF/SynapseRowCollection.h"
 #include "calibtic/HMF/SynapseSwitchCollection.h"
 
+#ifndef PYPLUSPLUS
+#include <functional>
+#endif // PYPLUSPLUS
+
 namespace HMF {
 
 class HICANNCollection :
@@ -52,6 +57,9 @@ public:
 
 	virtual std::ostream& operator<< (std::ostream&) const;
 
+	/// loads the sub-collections of both sides before comparing
+	virtual bool operator== (Base const& rhs) const;
+
     // Py++ factory function
 	static
 	boost::shared_ptr<HICANNCollection> create();
@@ -79,7 +87,41 @@ public:
 
 	virtual void copy(Collection const& rhs);
 
+#ifndef PYPLUSPLUS
+	/// returns the stored sub-collection with the given key, null if there
+	/// is none
+	typedef std::function<value_type(key_type)> section_loader;
+
+	/// Marks all sub-collections as not loaded yet. @param loader is called
+	/// once per sub-collection on its first access through at*Collection()
+	/// or at(), the result is copied into the current entry. Missing
+	/// sub-collections get their defaults, as in init_missing(). Entries
+	/// replaced in the meantime are left alone. Used by backends which can
+	/// load sub-collections independently.
+	///
+	/// Keys and size are known up front. at() called through a Collection
+	/// reference does not load, call loadSections() before accessing a lazy
+	/// collection that way.
+	void setSectionLoader(section_loader const& loader);
+#endif // PYPLUSPLUS
+
+	/// loads the entry before returning it, see setSectionLoader
+	value_type at(key_type const& key);
+#ifndef PYPLUSPLUS
+	const_value_type at(key_type const& key) const;
+
+	/// loads all sections before interning them
+	virtual void intern(calibtic::trafo::Pool& pool) PYPP_OVERRIDE;
+#endif // PYPLUSPLUS
+
+	/// loads all sub-collections not accessed yet, no-op if there is no
+	/// section loader
+	void loadSections() const;
+
 private:
+	/// loads the sub-collection with @param key if it was not accessed yet
+	void loadSection(key_type key) const;
+
 	friend class boost::serialization::access;
 	template<typename Archiver>
 	void serialize(Archiver& ar, unsigned int const);
@@ -104,9 +146,16 @@ private:
 			L1Crossbar = 3,
 			SynapseChainLength = 4,
 			SynapseSwitches = 5,
+			Size = 6
 		};
 	};
 
+#ifndef PYPLUSPLUS
+	struct Sections;
+	/// shared between copies, which share the sub-collections as well
+	boost::shared_ptr<Sections> mSections;
+#endif // PYPLUSPLUS
+
 };
 
 } // HMF
@@ -120,6 +169,10 @@ template<typename Archiver>
 void HICANNCollection::serialize(Archiver& ar, unsigned int const version)
 {
 	using namespace boost::serialization;
+	// sections not loaded yet are stored, or are resolved now so they do not
+	// overwrite the deserialized ones later on
+	loadSections();
+
 	if (version < 1)
 	{
 		// old serialization without ESS
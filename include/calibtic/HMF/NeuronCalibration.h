@@ -154,6 +154,24 @@ public:
 		double const speedup,
 		NeuronCalibrationParameters const& = NeuronCalibrationParameters()) const;
 
+#ifndef PYPLUSPLUS
+	/// calibrates the @param n neurons at @param index: p[index[ii]] is
+	/// transformed to out[index[ii]]. Same result as applyNeuronCalibration
+	/// for each neuron, but each transformation is applied to all neurons at
+	/// once.
+	void applyNeuronCalibration(
+		PyNNParameters::EIF_cond_exp_isfa_ista const* p,
+		size_t const* index, size_t const n,
+		double const speedup, HWNeuronParameter* out,
+		NeuronCalibrationParameters const& = NeuronCalibrationParameters()) const;
+
+	void applyNeuronCalibration(
+		PyNNParameters::IF_cond_exp const* p,
+		size_t const* index, size_t const n,
+		double const speedup, HWNeuronParameter* out,
+		NeuronCalibrationParameters const& = NeuronCalibrationParameters()) const;
+#endif // PYPLUSPLUS
+
 	PyNNParameters::EIF_cond_exp_isfa_ista applyNeuronReverse(
 		HWNeuronParameter const& h,
 		double const speedup, double const cm_bio,
@@ -274,10 +292,31 @@ private:
 		double const speedup,
 		NeuronCalibrationParameters const&) const;
 
+	template<typename CellType>
+	void _applyNeuronCalibration(
+		CellType const* p,
+		size_t const* index, size_t const n,
+		double const speedup, HWNeuronParameter* out,
+		NeuronCalibrationParameters const&) const;
+
+	/// transforms the technical values @param v with calibration @param c
+	/// and writes the DAC values to hardware parameter @param hw of the
+	/// neurons at @param index of @param out. Neurons that cannot be
+	/// calibrated are set to @param fallback, unless it is negative.
+	void applyColumn(
+		std::vector<double> const& v,
+		Calibrations::calib const c, int const hw,
+		char const* name, hw_value const fallback,
+		size_t const* index, HWNeuronParameter* out) const;
+
 	void populateWithDefault(NeuronCalibration* cal) const;
 
 #ifndef PYPLUSPLUS
-	NeuronCalibration* mDefault;
+	/// the default calibration is immutable and built once per process,
+	/// all instances with a default share it
+	static boost::shared_ptr<NeuronCalibration const> sharedDefault();
+
+	boost::shared_ptr<NeuronCalibration const> mDefault;
 #endif
 
 	friend class boost::serialization::access;
@@ -1,9 +1,13 @@
 #pragma once
 
 #include "calibtic/Collection.h"
+#include "calibtic/Executor.h"
 #include "calibtic/HMF/NeuronCalibration.h"
 #include "calibtic/HMF/HWNeuronParameter.h"
+#include <algorithm>
 #include <iostream>
+#include <unordered_map>
+#include <vector>
 
 namespace HMF {
 
@@ -26,6 +30,37 @@ public:
 		PyNNParameters::IF_cond_exp const& model_params,
 		size_t const hw_neuron_id,
 		NeuronCalibrationParameters const& = {}) const;
+
+	/// calibrates neuron hw_neuron_ids[ii] with model_params[ii] for all
+	/// @param n neurons and writes the result to out[ii]. Neurons sharing a
+	/// NeuronCalibration are calibrated together.
+	void applyNeuronCalibration(
+		PyNNParameters::EIF_cond_exp_isfa_ista const* model_params,
+		size_t const* hw_neuron_ids, size_t const n,
+		HWNeuronParameter* out,
+		NeuronCalibrationParameters const& = {}) const;
+
+	void applyNeuronCalibration(
+		PyNNParameters::IF_cond_exp const* model_params,
+		size_t const* hw_neuron_ids, size_t const n,
+		HWNeuronParameter* out,
+		NeuronCalibrationParameters const& = {}) const;
+
+	/// same as above, the neurons are distributed over the threads of
+	/// @param executor
+	void applyNeuronCalibration(
+		PyNNParameters::EIF_cond_exp_isfa_ista const* model_params,
+		size_t const* hw_neuron_ids, size_t const n,
+		HWNeuronParameter* out,
+		calibtic::Executor& executor,
+		NeuronCalibrationParameters const& = {}) const;
+
+	void applyNeuronCalibration(
+		PyNNParameters::IF_cond_exp const* model_params,
+		size_t const* hw_neuron_ids, size_t const n,
+		HWNeuronParameter* out,
+		calibtic::Executor& executor,
+		NeuronCalibrationParameters const& = {}) const;
 #else
 	HWNeuronParameter applyNeuronCalibration(
 		PyNNParameters::EIF_cond_exp_isfa_ista const& model_params,
@@ -69,6 +104,16 @@ private:
 		size_t const hw_neuron_id,
 		NeuronCalibrationParameters const&) const;
 
+#ifndef PYPLUSPLUS
+	template<typename CellType>
+	void _applyNeuronCalibration(
+		CellType const* model_params,
+		size_t const* hw_neuron_ids, size_t const n,
+		HWNeuronParameter* out,
+		calibtic::Executor* executor,
+		NeuronCalibrationParameters const&) const;
+#endif // PYPLUSPLUS
+
 	size_t mSpeedup;
 	size_t mPLLFrequency;
 	size_t mStartingCycle;
@@ -107,4 +152,73 @@ HWNeuronParameter NeuronCollection::_applyNeuronCalibration(
     return calib.applyNeuronCalibration(model_params, mSpeedup, params);
 }
 
+#ifndef PYPLUSPLUS
+template<typename CellType>
+void NeuronCollection::_applyNeuronCalibration(
+	CellType const* model_params,
+	size_t const* hw_neuron_ids, size_t const n,
+	HWNeuronParameter* out,
+	calibtic::Executor* executor,
+	NeuronCalibrationParameters const& params) const
+{
+	// group the neurons by calibration, after setDefaults all neurons share one
+	std::unordered_map<NeuronCalibration const*, size_t> group_of;
+	std::vector<NeuronCalibration const*> calibs;
+	std::vector<std::vector<size_t> > groups;
+
+	for (size_t ii = 0; ii < n; ++ii) {
+		size_t const hw_neuron_id = hw_neuron_ids[ii];
+		if (!exists(hw_neuron_id) || !at(hw_neuron_id)) {
+			throw std::runtime_error("no calibration data for this neuron");
+		}
+
+		NeuronCalibration const* calib =
+			dynamic_cast<NeuronCalibration const*>(at(hw_neuron_id).get());
+		if (!calib) {
+			throw std::runtime_error("calibration data of this neuron is no NeuronCalibration");
+		}
+
+		auto const it = group_of.insert(std::make_pair(calib, groups.size())).first;
+		if (it->second == groups.size()) {
+			calibs.push_back(calib);
+			groups.emplace_back();
+		}
+		groups[it->second].push_back(ii);
+	}
+
+	if (!executor) {
+		for (size_t gg = 0; gg < groups.size(); ++gg) {
+			calibs[gg]->applyNeuronCalibration(
+				model_params, groups[gg].data(), groups[gg].size(), mSpeedup, out, params);
+		}
+		return;
+	}
+
+	// large groups are split into tasks, each task writes to distinct neurons
+	size_t const neurons_per_task = 64;
+	struct Task {
+		size_t group;
+		size_t begin;
+		size_t end;
+	};
+	std::vector<Task> tasks;
+	for (size_t gg = 0; gg < groups.size(); ++gg) {
+		for (size_t begin = 0; begin < groups[gg].size(); begin += neurons_per_task) {
+			Task const task = {
+				gg, begin, std::min(groups[gg].size(), begin + neurons_per_task)};
+			tasks.push_back(task);
+		}
+	}
+
+	executor->parallel_for(tasks.size(), [&](size_t const begin, size_t const end) {
+		for (size_t tt = begin; tt < end; ++tt) {
+			Task const& task = tasks[tt];
+			calibs[task.group]->applyNeuronCalibration(
+				model_params, groups[task.group].data() + task.begin,
+				task.end - task.begin, mSpeedup, out, params);
+		}
+	});
+}
+#endif // PYPLUSPLUS
+
 } // HMF
@@ -1,4 +1,7 @@
 #pragma once
+#include <array>
+#include <cstdint>
+#include <memory>
 #include <stdexcept>
 
 #include <boost/serialization/serialization.hpp>
@@ -7,6 +10,7 @@
 #include <iostream>
 
 #include "calibtic/Calibration.h"
+#include "calibtic/util.h"
 #include "hal/HICANNContainer.h"
 
 namespace HMF {
@@ -35,6 +39,31 @@ public:
 		double const analog_weight //<! analog weight in nano Siemens.
 		) const;
 
+	/// same as above, but the stochastic rounding uses the counter-based
+	/// generator of @param seed and @param synapse, e.g. the enum of the
+	/// synapse coordinate, instead of the global rand(). The result only
+	/// depends on the arguments, so it is thread-safe and reproducible.
+	HICANN::SynapseWeight getDigitalWeight(
+		double const analog_weight,
+		uint64_t const seed,
+		uint64_t const synapse) const;
+
+#ifndef PYPLUSPLUS
+	/// same as above, the random number is drawn from @param rng
+	HICANN::SynapseWeight getDigitalWeight(
+		double const analog_weight,
+		calibtic::Philox4x32& rng) const;
+
+	/// quantizes the @param n analog weights at @param analog_weight, e.g. a
+	/// synapse row or weight matrix, and writes them to @param out. Weight ii
+	/// is rounded like getDigitalWeight(analog_weight[ii], seed, first_synapse + ii).
+	void getDigitalWeights(
+		double const* analog_weight, size_t const n,
+		HICANN::SynapseWeight* out,
+		uint64_t const seed,
+		uint64_t const first_synapse) const;
+#endif // PYPLUSPLUS
+
 	/// returns analog weight for a given digital weight in nano Siemens.
 	analog_weight_t getAnalogWeight(HICANN::SynapseWeight const digital_weight) const;
 
@@ -55,6 +84,34 @@ public:
 	/// checks whether analog weights are monotonic increasing for increasing digital weights.
 	bool check_monotonic_increasing() const;
 private:
+#ifndef PYPLUSPLUS
+	static size_t const num_weights = HICANN::SynapseWeight::max + 1;
+
+	/// analog weights of all digital weights
+	struct WeightTable
+	{
+		/// the transformation the table was built from, kept alive so that
+		/// its address cannot be reused by a replacement
+		calibtic::Calibration::const_value_type trafo;
+		std::array<analog_weight_t, num_weights> analog;
+		bool monotonic;
+	};
+
+	/// returns the table of the current transformation, builds it if the
+	/// transformation has been replaced
+	std::shared_ptr<WeightTable const> weightTable() const;
+
+	/// @param uniform returns a random number in [0, 1], it is only called
+	/// if the analog weight lies between two digital weights
+	template<typename Uniform>
+	HICANN::SynapseWeight _getDigitalWeight(
+		WeightTable const& table, double const analog_weight,
+		Uniform const& uniform) const;
+
+	/// not serialized, shared between copies since it is never modified
+	mutable std::shared_ptr<WeightTable const> mWeightTable;
+#endif // PYPLUSPLUS
+
 	friend class boost::serialization::access;
 	template<typename Archiver>
 	void serialize(Archiver& ar, unsigned int const);
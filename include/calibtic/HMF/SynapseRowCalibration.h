@@ -5,6 +5,8 @@
 #include <boost/serialization/nvp.hpp>
 #include <boost/serialization/export.hpp>
 #include <iostream>
+#include <utility>
+#include <vector>
 
 #include "calibtic/Base.h"
 #include "hal/HICANNContainer.h"
@@ -32,6 +34,7 @@ public:
 	typedef size_t size_type;
 
 public:
+	SynapseRowCalibration();
 	virtual ~SynapseRowCalibration();
 
 	void setDefaults();
@@ -41,12 +44,20 @@ public:
 
 	// get synapse calibration.
 	// raises exception if there is no calibration for this gmax config
+	// Note: the non-const version invalidates the maximum weights cached by
+	// findBestGmaxConfig, calibrations modified through older pointers are
+	// not detected.
 	const_value_type at(key_type const key) const;
 	value_type       at(key_type const key);
 
 	// gets number of existing calibrations
 	size_type size() const;
 
+#ifndef PYPLUSPLUS
+	// gmax configs of all existing calibrations in ascending order
+	std::vector<key_type> keys() const;
+#endif // PYPLUSPLUS
+
 	// insert new calibration for a new gmax config (key).
 	// raises exception if there already exists a calibration for the given key.
 	void insert(key_type const& key,
@@ -67,6 +78,8 @@ public:
 	/// If required weight is higher than the maximum analog weight, the Configuration with the highest maximum
 	/// weight is returned.
 	/// If no synapse calibration is available, the default setting is returned.
+	/// The maximum analog weights of all configs are cached in a sorted array,
+	/// each call is a binary search.
 	GmaxConfig findBestGmaxConfig(double max_required_weight);
 
 	virtual bool operator== (Base const& rhs) const;
@@ -79,10 +92,22 @@ public:
 
 	virtual void copy(SynapseRowCalibration const&);
 
+#ifndef PYPLUSPLUS
+	virtual void intern(calibtic::trafo::Pool& pool);
+#endif // PYPLUSPLUS
+
 protected:
 	std::map<key_type, value_type> mTrafo;
 
 private:
+	/// sorts the configs by maximum analog weight
+	void updateMaxWeights();
+
+	/// (maximum analog weight, config) sorted by weight, then config. Not
+	/// serialized, rebuilt after mTrafo changed.
+	std::vector<std::pair<double, key_type> > mMaxWeights;
+	bool mMaxWeightsValid;
+
 	friend class boost::serialization::access;
 	template<typename Archiver>
 	void serialize(Archiver& ar, unsigned int const);
@@ -100,6 +125,9 @@ void SynapseRowCalibration::serialize(Archiver& ar, unsigned int const)
 {
 	using namespace boost::serialization;
 	ar & make_nvp("trafo", mTrafo);
+	if (Archiver::is_loading::value) {
+		mMaxWeightsValid = false;
+	}
 }
 #endif // PYPLUSPLUS
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "calibtic/Collection.h"
+#include "calibtic/HMF/GmaxConfig.h"
 
 namespace HMF {
 
@@ -25,6 +26,14 @@ public:
 
 	virtual void copy(calibtic::Collection const&);
 
+#ifndef PYPLUSPLUS
+	/// SynapseRowCalibration::findBestGmaxConfig of row rows[ii] for
+	/// max_required_weight[ii] for all @param n rows, written to out[ii]
+	void findBestGmaxConfig(
+		double const* max_required_weight, size_t const* rows, size_t const n,
+		GmaxConfig* out);
+#endif // PYPLUSPLUS
+
 private:
 	friend class boost::serialization::access;
 	template<typename Archiver>
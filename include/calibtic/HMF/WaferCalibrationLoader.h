@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include "calibtic/Executor.h"
+#include "calibtic/backend/Backend.h"
+#include "calibtic/HMF/HICANNCollection.h"
+
+namespace HMF {
+
+/// Loads the HICANNCollections of many HICANNs of a wafer concurrently.
+///
+/// Data sets are named "w<wafer>-h<hicann>" as written by the calibration
+/// tools. All loads share one backend and run on the threads of an Executor,
+/// at most max_concurrent of them at the same time. This bounds the number of
+/// open files and of archives being deserialized at once. A failed load does
+/// not stop the others, all errors are collected.
+class WaferCalibrationLoader
+{
+public:
+	typedef std::map<size_t, boost::shared_ptr<HICANNCollection> > collections_type;
+	typedef std::map<size_t, std::string> errors_type;
+
+	/// @param backend has to be initialized. @param executor may be null, a
+	/// pool of max_concurrent threads is created then. @param max_concurrent
+	/// 0 uses all threads of the executor.
+	WaferCalibrationLoader(
+		boost::shared_ptr<calibtic::backend::Backend> backend,
+		boost::shared_ptr<calibtic::Executor> executor =
+			boost::shared_ptr<calibtic::Executor>(),
+		size_t max_concurrent = 0);
+
+	/// loads the data sets of @param hicanns (enum values of HICANNOnWafer)
+	/// on @param wafer. HICANNs which could not be loaded are missing in the
+	/// result, errors() lists them with the reason.
+	collections_type load(size_t wafer, std::vector<size_t> const& hicanns);
+
+	/// errors of the last call to load by HICANN, empty if all were loaded
+	errors_type const& errors() const;
+
+	/// throws a std::runtime_error listing all errors of the last load, if
+	/// there were any
+	void throwOnErrors() const;
+
+	/// data set name of @param hicann on @param wafer
+	static std::string name(size_t wafer, size_t hicann);
+
+private:
+	boost::shared_ptr<calibtic::backend::Backend> mBackend;
+	boost::shared_ptr<calibtic::Executor> mExecutor;
+	size_t mMaxConcurrent;
+	errors_type mErrors;
+};
+
+} // HMF
@@ -2,23 +2,44 @@
 
 #include <string>
 #include <map>
+#include <vector>
 
 #include <boost/shared_ptr.hpp>
 #include <boost/variant.hpp>
 
+#ifndef PYPLUSPLUS
+#include <functional>
+#include <future>
+#include <mutex>
+#endif // PYPLUSPLUS
+
 #include "calibtic/MetaData.h"
 
 namespace calibtic {
 
 // fwd decls
+class Base;
 class Collection;
 class Calibration;
 
+namespace trafo {
+class Pool;
+} // trafo
+
 namespace backend {
 
 class Library; // fwd decl
 
 /// Abstract base class for all storage backends
+///
+/// After init(), data sets may be loaded from several threads at the same
+/// time. Configuration changes and stores need exclusive access.
+///
+/// load_async and store_async run on an I/O thread owned by the backend, one
+/// operation after the other in the order they were issued. They run on the
+/// derived object, so BackendDeleter waits for them before destroying it. The
+/// concrete backends also wait in their destructors, for instances that are
+/// not deleted through a BackendDeleter.
 class Backend
 {
 public:
@@ -55,6 +76,45 @@ public:
 		 MetaData& metadata,
 		 boost::shared_ptr<Calibration> & ptr) = 0;
 
+	/// loads only the entries with @param keys of the collection stored as
+	/// @param id, keys without a stored entry are skipped. The default
+	/// implementation loads the whole collection and drops all other
+	/// entries, backends with an index read the requested entries only.
+	virtual void
+	load(std::string const& id,
+		 MetaData& metadata,
+		 Collection&,
+		 std::vector<int> const& keys);
+
+#ifndef PYPLUSPLUS
+	/// loads the data set @param id into @param c on the I/O thread, the
+	/// future returns its metadata or rethrows the error of the load. @param c
+	/// must not be accessed before the future is ready.
+	std::future<MetaData>
+	load_async(std::string const& id,
+			   boost::shared_ptr<Collection> c);
+
+	std::future<MetaData>
+	load_async(std::string const& id,
+			   boost::shared_ptr<Calibration> c);
+
+	/// stores @param c on the I/O thread, @param c must not be modified
+	/// before the future is ready
+	std::future<void>
+	store_async(std::string const& id,
+				MetaData const& metadata,
+				boost::shared_ptr<Collection const> c);
+
+	std::future<void>
+	store_async(std::string const& id,
+				MetaData const& metadata,
+				boost::shared_ptr<Calibration const> c);
+#endif // PYPLUSPLUS
+
+	/// blocks until all asynchronous operations issued before the call are
+	/// done, operations issued meanwhile are not waited for
+	void wait();
+
 	virtual void
 	store(std::string const& id,
 		  MetaData const& metadata,
@@ -80,6 +140,18 @@ protected:
 	// returns true or falls wheter or not key exists in map
 	bool exists(std::string const& key) const;
 
+	/// if the option "deduplicate" is set to a non-zero int, structurally
+	/// equal transformations in @param base are replaced by one shared
+	/// instance. The pool is kept for all loads of this backend, so the
+	/// transformations of all loaded objects must not be modified.
+	void deduplicate(Base& base);
+
+#ifndef PYPLUSPLUS
+	/// the pool used by deduplicate, null if the option is not set. For
+	/// backends interning objects that are loaded later on.
+	boost::shared_ptr<trafo::Pool> getPool();
+#endif // PYPLUSPLUS
+
 	template<typename T>
 	T& get(std::string const& key);
 
@@ -100,6 +172,19 @@ private:
 #endif
 
 	config_map_t  mConfig;
+
+#ifndef PYPLUSPLUS
+	/// runs @param f on the I/O thread, which is started on first use
+	template<typename Return>
+	std::future<Return> enqueue(std::function<Return()> const& f);
+
+	std::mutex mPoolMutex;
+	boost::shared_ptr<trafo::Pool> mPool;
+
+	class AsyncQueue;
+	std::mutex mAsyncMutex;
+	boost::shared_ptr<AsyncQueue> mAsync;
+#endif
 };
 
 boost::shared_ptr<Backend>
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <iosfwd>
+#include <string>
+
+#include <boost/shared_ptr.hpp>
+
+namespace calibtic {
+namespace backend {
+
+/// Compression of the files written by the archive based backends, selected
+/// by their option "compression".
+///
+/// Compressed files consist of the frames of the respective format (zstd or
+/// gzip), their headers identify the format when reading. Data is compressed
+/// and decompressed while the archive is written or read, no temporary copy
+/// of the file is kept in memory.
+///
+/// zstd needs Boost >= 1.70 with Iostreams built against libzstd, which is
+/// checked when configuring (CALIBTIC_HAVE_ZSTD). Without it, "zstd" is
+/// rejected like an unknown name and zstd files cannot be read.
+enum class Compression
+{
+	none,
+	gzip,
+	zstd
+};
+
+/// parses @param name, one of "none", "gzip" or "zstd", throws
+/// std::runtime_error for unknown or unsupported names
+Compression compression(std::string const& name);
+
+/// opens @param file for reading, compressed files are detected by their
+/// frame header and decompressed on the fly
+boost::shared_ptr<std::istream> openInput(std::string const& file);
+
+/// opens @param file for writing, the data is compressed with
+/// @param compression. The stream has to be destroyed to finish the file.
+boost::shared_ptr<std::ostream> openOutput(std::string const& file,
+                                           Compression compression);
+
+} // backend
+} // calibtic
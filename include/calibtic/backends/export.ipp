@@ -31,6 +31,7 @@
 
 #include "calibtic/HMF/ADC/ADCCalibration.h"
 #include "calibtic/HMF/ADC/QuadraticADCCalibration.h"
+#include "calibtic/HMF/ADC/LUTADCCalibration.h"
 
 BOOST_CLASS_EXPORT(calibtic::trafo::Transformation)
 BOOST_CLASS_EXPORT(calibtic::trafo::Constant)
@@ -67,6 +68,7 @@ BOOST_CLASS_EXPORT(HMF::SynapseSwitchCalibration)
 
 BOOST_CLASS_EXPORT(HMF::ADC::ADCCalibration)
 BOOST_CLASS_EXPORT(HMF::ADC::QuadraticADCCalibration)
+BOOST_CLASS_EXPORT(HMF::ADC::LUTADCCalibration)
 
 #include <boost/serialization/void_cast.hpp>
 
@@ -97,6 +99,7 @@ static int __void_cast_register()
 
 	void_cast_register<HMF::ADC::ADCCalibration, Calibration>();
 	void_cast_register<HMF::ADC::QuadraticADCCalibration, Calibration>();
+	void_cast_register<HMF::ADC::LUTADCCalibration, Calibration>();
 
 	return 0;
 }
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstdint>
+
+namespace calibtic {
+namespace backend {
+namespace mmap {
+
+/// Layout of the files written by MmapBackend.
+///
+/// A file starts with a Header followed by the sections listed in it. Each
+/// section is an array of one record type, starts at a multiple of 8 bytes and
+/// is read in place from the mapped file. Integers and doubles are stored in
+/// native byte order, files are rejected on machines with a different order.
+///
+/// Objects and transformations are written children first, so every index
+/// refers to an earlier record. Objects and transformations shared between
+/// several parents are stored once and shared again after loading.
+
+char const magic[8] = {'C', 'A', 'L', 'I', 'B', 'M', 'A', 'P'};
+uint32_t const version = 1;
+uint32_t const byte_order = 0x01020304;
+
+/// null pointer in CHILDREN, TRAFO_CHILDREN and Header::root
+uint32_t const none = 0xffffffff;
+
+enum Section : uint32_t
+{
+	STRINGS,        ///< char, referenced by byte offset and size
+	OBJECTS,        ///< Object
+	KEYS,           ///< int64_t, key of the entry with the same index in CHILDREN
+	CHILDREN,       ///< uint32_t, object or transformation index
+	SCALARS,        ///< uint64_t, members of objects besides their children
+	TRAFOS,         ///< Trafo
+	TRAFO_CHILDREN, ///< uint32_t, transformation index
+	COEFFICIENTS,   ///< double
+	BLOBS,          ///< Boost binary archives of types without a flat record
+	NUM_SECTIONS
+};
+
+struct Range
+{
+	uint64_t offset; ///< in bytes from the start of the file
+	uint64_t size;   ///< in bytes
+};
+
+struct MetaRecord
+{
+	int64_t id;
+	int64_t creation;
+	int64_t modification;
+	Range author;  ///< in STRINGS
+	Range comment; ///< in STRINGS
+};
+
+struct Header
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t byte_order;
+	uint64_t file_size;
+	uint32_t root;     ///< index of the stored object in OBJECTS
+	uint32_t reserved;
+	MetaRecord metadata;
+	Range sections[NUM_SECTIONS];
+};
+
+enum ObjectType : uint32_t
+{
+	/// any other type, Boost binary archive of a shared_ptr<Base>
+	OBJECT_BLOB,
+
+	// collections, children are (key, object index) pairs sorted by key
+	COLLECTION,
+	NEURON_COLLECTION,  ///< scalars: speedup, pll frequency, starting cycle
+	HICANN_COLLECTION,  ///< scalars: speedup, pll frequency, starting cycle
+	BLOCK_COLLECTION,
+	SYNAPSE_ROW_COLLECTION,
+	L1_CROSSBAR_COLLECTION,
+	SYNAPSE_CHAIN_LENGTH_COLLECTION,
+	SYNAPSE_SWITCH_COLLECTION,
+
+	// calibrations, children are (position, transformation index) pairs
+	CALIBRATION,
+	NEURON_CALIBRATION,
+	SHARED_CALIBRATION,
+	SYNAPSE_CALIBRATION,
+	ADC_CALIBRATION,
+	L1_CROSSBAR_CALIBRATION,          ///< scalars: per row, per column
+	SYNAPSE_CHAIN_LENGTH_CALIBRATION, ///< scalars: max chain length
+	SYNAPSE_SWITCH_CALIBRATION,       ///< scalars: max switches
+
+	/// children are (sel_Vgmax << 8 | gmax_div, SynapseCalibration index)
+	SYNAPSE_ROW_CALIBRATION
+};
+
+struct Object
+{
+	uint32_t type;
+	uint32_t count;   ///< number of children
+	uint64_t first;   ///< first child in KEYS and CHILDREN, blob offset in BLOBS
+	uint64_t scalars; ///< first entry in SCALARS, blob size in BLOBS
+};
+
+enum TrafoType : uint32_t
+{
+	/// any other type, Boost binary archive of a shared_ptr<Transformation>
+	TRAFO_BLOB,
+	CONSTANT,                   ///< value in COEFFICIENTS
+	POLYNOMIAL,                 ///< coefficients in COEFFICIENTS
+	NEGATIVE_POWERS_POLYNOMIAL, ///< coefficients in COEFFICIENTS
+	SUM_OF_TRAFOS,              ///< summands in TRAFO_CHILDREN
+	POWER_OF_TRAFO              ///< base in TRAFO_CHILDREN, may be none
+};
+
+struct Trafo
+{
+	uint32_t type;
+	uint32_t count;  ///< number of coefficients or children, blob size
+	uint64_t first;  ///< first entry in COEFFICIENTS or TRAFO_CHILDREN, blob offset
+	double domain[2];
+	double reverse_domain[2];
+	uint32_t bounds; ///< interval bounds of domain | reverse domain << 8
+	uint32_t reserved;
+	double power;    ///< exponent of POWER_OF_TRAFO
+};
+
+static_assert(sizeof(Header) % 8 == 0, "unaligned header");
+static_assert(sizeof(Object) == 24, "unexpected padding");
+static_assert(sizeof(Trafo) == 64, "unexpected padding");
+
+} // mmap
+} // backend
+} // calibtic
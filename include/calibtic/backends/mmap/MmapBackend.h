@@ -0,0 +1,98 @@
+#pragma once
+
+#include <boost/filesystem.hpp>
+
+#include <log4cxx/logger.h>
+
+#include "calibtic/backend/Backend.h"
+
+namespace calibtic {
+namespace backend {
+
+extern log4cxx::LoggerPtr logger;
+
+/// Stores each data set as flat file <id>.cmap (see mmap/Format.h).
+///
+/// On load the file is mapped and its records are read in place, objects are
+/// created directly from them without parsing an archive. Types without a
+/// flat record are embedded as Boost binary archives. Files are written to a
+/// temporary file first and renamed, so concurrent readers see either the old
+/// or the new data set.
+///
+/// If the option "lazy" is set to a non-zero int, a stored HICANNCollection is
+/// returned without its sub-collections, each one is created on its first
+/// access (see HICANNCollection::setSectionLoader). The file stays mapped as
+/// long as the collection or a copy of it exists.
+class MmapBackend :
+	public Backend
+{
+public:
+	MmapBackend();
+	virtual ~MmapBackend();
+
+	virtual void init();
+
+	using Backend::load;
+
+	virtual void
+	load(std::string const& id,
+		 MetaData& metadata,
+		 Collection&);
+
+	virtual void
+	load(std::string const& id,
+		 MetaData& metadata,
+		 Calibration&);
+
+	virtual void
+	load(std::string const& id,
+		 MetaData& metadata,
+		 boost::shared_ptr<Calibration> & ptr);
+
+	/// creates the requested entries only, found by binary search in the
+	/// sorted keys of the stored collection
+	virtual void
+	load(std::string const& id,
+		 MetaData& metadata,
+		 Collection&,
+		 std::vector<int> const& keys);
+
+	virtual void
+	store(std::string const& id,
+		  MetaData const& metadata,
+		  Collection const&);
+
+	virtual void
+	store(std::string const& id,
+		  MetaData const& metadata,
+		  Calibration const&);
+
+	virtual void
+	store(std::string const& id,
+		 MetaData const& metadata,
+		 boost::shared_ptr<const Calibration> ptr);
+
+private:
+	typedef boost::filesystem::path path;
+
+	template<typename T>
+	void load(std::string const& id,
+			  MetaData& metadata,
+			  boost::shared_ptr<T>& t);
+
+	void store(std::string const& id,
+			   MetaData const& metadata,
+			   boost::shared_ptr<Base const> t);
+
+	path&       getPath();
+	path const& getPath() const;
+
+	path
+	getFilename(std::string const& id,
+				MetaData const& metadata) const;
+
+	path  mPath;
+};
+
+} // backend
+} // calibtic
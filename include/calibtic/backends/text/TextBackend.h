@@ -10,12 +10,15 @@
 #include <log4cxx/logger.h>
 
 #include "calibtic/backend/Backend.h"
+#include "calibtic/backend/Compression.h"
 
 namespace calibtic {
 namespace backend {
 
 extern log4cxx::LoggerPtr logger;
 
+/// The option "compression" (see Compression) selects the compression of
+/// stored files, compressed and uncompressed files are read in any case.
 class TextBackend :
 	public Backend
 {
@@ -25,6 +28,8 @@ public:
 
 	virtual void init();
 
+	using Backend::load;
+
 	virtual void
 	load(std::string const& id,
 		 MetaData& metadata,
@@ -78,6 +83,7 @@ private:
 				MetaData const& metadata) const;
 
 	path  mPath;
+	Compression mCompression;
 };
 
 } // backend
@@ -104,12 +110,16 @@ void TextBackend::load(char const* label,
 		    std::string("data set not found: ") + file.string());
 	}
 
-	std::fstream stream(file.string(), std::ios::in | std::ios::binary);
+	auto const stream = openInput(file.string());
 
-	boost::archive::text_iarchive ia(stream);
+	boost::archive::text_iarchive ia(*stream);
 
 	ia >> boost::serialization::make_nvp("metadata", metadata);
 	ia >> boost::serialization::make_nvp(label, t);
+
+	if (t) {
+		deduplicate(*t);
+	}
 }
 
 template<typename T>
@@ -119,9 +129,10 @@ void TextBackend::store(char const* label,
 					   T const& t)
 {
 	auto file = getFilename(id, metadata);
-	std::fstream stream(file.string(), std::ios::out | std::ios::binary);
+	// destroyed after the archive, which may write on destruction
+	auto const stream = openOutput(file.string(), mCompression);
 
-	boost::archive::text_oarchive oa(stream);
+	boost::archive::text_oarchive oa(*stream);
 
 	oa << boost::serialization::make_nvp("metadata", metadata);
 	oa << boost::serialization::make_nvp(label, t);
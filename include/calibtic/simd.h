@@ -0,0 +1,20 @@
+#pragma once
+
+namespace calibtic {
+namespace simd {
+
+/// instruction set extensions used by vectorized kernels
+enum Kernel {
+	SCALAR, //!< portable fallback
+	AVX2,   //!< 256 bit vectors
+	AVX512  //!< 512 bit vectors (AVX-512F)
+};
+
+/// returns true if @param kernel can be executed on this cpu
+bool supported(Kernel kernel);
+
+/// the widest kernel supported by this cpu, determined once at runtime
+Kernel best();
+
+} // simd
+} // calibtic
@@ -21,12 +21,22 @@ struct Constant :
 	virtual float_type
 	reverseApply(float_type const& in, Transformation::OutsideDomainBehavior outside_domain_behavior=Transformation::IGNORE) const;
 
+#ifndef PYPLUSPLUS
+	virtual void
+	apply(float_type const* in, float_type* out, size_t n, Transformation::OutsideDomainBehavior outside_domain_behavior=Transformation::IGNORE) const;
+
+	virtual void
+	reverseApply(float_type const* in, float_type* out, size_t n, Transformation::OutsideDomainBehavior outside_domain_behavior=Transformation::IGNORE) const;
+#endif // PYPLUSPLUS
+
 	virtual bool
 	operator== (Transformation const& rhs) const;
 
 	virtual std::ostream&
 	operator<< (std::ostream& os) const;
 
+	virtual size_t hash() const;
+
 	float_type getData() const;
 
 #ifndef PYPLUSPLUS
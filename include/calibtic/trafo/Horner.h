@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+
+#include "calibtic/config.h"
+#include "calibtic/simd.h"
+
+namespace calibtic {
+namespace trafo {
+namespace horner {
+
+/// evaluates sum_i coeff[i] * x^i using Horner's rule
+float_type evaluate(float_type const* coeff, size_t ncoeff, float_type x);
+
+/// evaluates sum_i coeff[i] * x^-i using Horner's rule in 1/x
+float_type evaluate_negative_powers(float_type const* coeff, size_t ncoeff, float_type x);
+
+/// batch version of evaluate, @param out may be identical to @param in.
+/// All kernels produce bit-identical results.
+void evaluate(float_type const* coeff, size_t ncoeff,
+              float_type const* in, float_type* out, size_t n,
+              simd::Kernel kernel = simd::best());
+
+/// batch version of evaluate_negative_powers, @param out may be identical to
+/// @param in. All kernels produce bit-identical results.
+void evaluate_negative_powers(float_type const* coeff, size_t ncoeff,
+                              float_type const* in, float_type* out, size_t n,
+                              simd::Kernel kernel = simd::best());
+
+} // horner
+} // trafo
+} // calibtic
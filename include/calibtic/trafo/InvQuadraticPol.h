@@ -35,10 +35,19 @@ public:
 	virtual float_type
 	reverseApply(float_type const& in, Transformation::OutsideDomainBehavior outside_domain_behavior=Transformation::CLIP) const;
 
+#ifndef PYPLUSPLUS
+	virtual void apply(float_type const* in, float_type* out, size_t n, Transformation::OutsideDomainBehavior outside_domain_behavior=Transformation::CLIP) const;
+
+	virtual void
+	reverseApply(float_type const* in, float_type* out, size_t n, Transformation::OutsideDomainBehavior outside_domain_behavior=Transformation::CLIP) const;
+#endif // PYPLUSPLUS
+
 	virtual bool operator== (Transformation const& rhs) const;
 
 	virtual std::ostream& operator<< (std::ostream& os) const;
 
+	virtual size_t hash() const;
+
 	// factory function for Py++
 	static
 	boost::shared_ptr<InvQuadraticPol> create(
@@ -48,6 +57,8 @@ public:
         float_type const& max = CALIBTIC_DOMAIN_MAX);
 
 private:
+	float_type evaluate(float_type const val) const;
+
 	friend class boost::serialization::access;
 	template<typename Archiver>
 	void serialize(Archiver& ar, unsigned int const)
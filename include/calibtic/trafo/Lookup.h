@@ -17,6 +17,19 @@ struct Lookup:
 {
 	typedef std::vector<float_type> data_type;
 
+	/// All modes return the same result, they differ in speed only.
+	enum search_mode
+	{
+		SEARCH_BINARY_FALLING,
+		SEARCH_BINARY_RAISING,
+		/// branchless search in a copy of the data in Eytzinger (BFS) order
+		SEARCH_EYTZINGER_FALLING,
+		SEARCH_EYTZINGER_RAISING,
+		/// interpolated first guess followed by an exponential search
+		SEARCH_INTERPOLATION_FALLING,
+		SEARCH_INTERPOLATION_RAISING,
+	};
+
 	Lookup(data_type const& data = data_type(), size_t offset=0);
 	virtual ~Lookup();
 
@@ -26,41 +39,85 @@ struct Lookup:
 	virtual float_type
 	reverseApply(float_type const& in, Transformation::OutsideDomainBehavior outside_domain_behavior=Transformation::CLIP) const;
 
+#ifndef PYPLUSPLUS
+	virtual void
+	apply(float_type const* in, float_type* out, size_t n, Transformation::OutsideDomainBehavior outside_domain_behavior=Transformation::CLIP) const;
+
+	virtual void
+	reverseApply(float_type const* in, float_type* out, size_t n, Transformation::OutsideDomainBehavior outside_domain_behavior=Transformation::CLIP) const;
+#endif // PYPLUSPLUS
+
 	virtual bool
 	operator== (Transformation const& rhs) const;
 
 	virtual std::ostream&
 	operator<< (std::ostream& os) const;
 
+	virtual size_t hash() const;
+
 	const data_type & getData() const;
 
+	search_mode getSearchMode() const;
+
+	/// selects another search mode of the same direction, e.g. to compare them
+	void setSearchMode(search_mode mode);
+
 	// factory function for Py++
 	static
 	boost::shared_ptr<Lookup>
 	create(data_type const& data = data_type(), size_t offset=0);
 
 private:
-	enum search_mode
-	{
-		SEARCH_BINARY_FALLING,
-		SEARCH_BINARY_RAISING,
-	};
-
 	data_type mData;
 	size_t mOffset;
 	search_mode mSearchMode;
 
+	/// mData in Eytzinger order starting at index 1 and the corresponding
+	/// indices in mData, index 0 stands for "not found"
+	data_type mEytzinger;
+	std::vector<size_t> mEytzingerIndex;
+
+	/// picks the fastest search mode for @param data
 	static search_mode determineSearchMode(const data_type & data);
 
+	/// binary search mode with the same direction as @param mode
+	static search_mode binarySearchMode(search_mode mode);
+
+	bool raising() const;
+
+	void buildEytzinger();
+
+	/// index of the first entry not before @param val, i.e.
+	/// std::lower_bound for raising and falling data
+	template <typename Compare>
+	size_t lowerBoundBinary(float_type val, Compare comp) const;
+	template <typename Compare>
+	size_t lowerBoundEytzinger(float_type val, Compare comp) const;
+	template <typename Compare>
+	size_t lowerBoundInterpolation(float_type val, Compare comp) const;
+
+	template <typename Search>
+	void lookupAll(float_type* values, size_t n, Search const& search) const;
+
 	friend class boost::serialization::access;
 	template<typename Archiver>
 	void serialize(Archiver& ar, unsigned int const)
 	{
 		using namespace boost::serialization;
+
+		// only the direction is stored to stay readable by older versions,
+		// the layout is chosen again when loading
+		search_mode search_mode_direction = binarySearchMode(mSearchMode);
+
 		ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(Transformation)
 		   & make_nvp("data", mData)
 		   & make_nvp("offset", mOffset)
-		   & make_nvp("search_mode", mSearchMode);
+		   & make_nvp("search_mode", search_mode_direction);
+
+		if (Archiver::is_loading::value) {
+			mSearchMode = determineSearchMode(mData);
+			buildEytzinger();
+		}
 	}
 };
 
@@ -31,6 +31,18 @@ public:
 	virtual float_type
 	reverseApply(float_type const& in, Transformation::OutsideDomainBehavior outside_domain_behavior=Transformation::THROW) const;
 
+#ifndef PYPLUSPLUS
+	virtual void
+	apply(float_type const* in, float_type* out, size_t n, Transformation::OutsideDomainBehavior outside_domain_behavior=Transformation::THROW) const;
+
+	virtual void
+	reverseApply(float_type const* in, float_type* out, size_t n, Transformation::OutsideDomainBehavior outside_domain_behavior=Transformation::THROW) const;
+
+	/// the check of apply for inputs of 0, for evaluators that inline the
+	/// transformation (Program, CompactCalibration)
+	void checkInput(float_type const* in, size_t n) const;
+#endif // PYPLUSPLUS
+
 	virtual bool
 	operator== (Transformation const& rhs) const;
 
@@ -47,6 +59,11 @@ public:
 	virtual data_type
 	find_real_roots(float_type const val, bool in_domain) const;
 
+protected:
+	virtual bool solver_interval(float_type& lower, float_type& upper) const;
+
+	virtual float_type from_solver_variable(float_type const t) const;
+
 private:
 	data_type mData;
 
@@ -31,14 +31,32 @@ public:
 	virtual float_type
 	reverseApply(float_type const& in, Transformation::OutsideDomainBehavior outside_domain_behavior=Transformation::CLIP) const;
 
+#ifndef PYPLUSPLUS
+	virtual void
+	apply(float_type const* in, float_type* out, size_t n, Transformation::OutsideDomainBehavior outside_domain_behavior=Transformation::CLIP) const;
+
+	virtual void
+	reverseApply(float_type const* in, float_type* out, size_t n, Transformation::OutsideDomainBehavior outside_domain_behavior=Transformation::CLIP) const;
+#endif // PYPLUSPLUS
+
 	virtual std::ostream&
 	operator<< (std::ostream& os) const;
 
 	virtual bool
 	operator== (Transformation const& rhs) const;
 
+	virtual size_t hash() const;
+
 	data_type const& getData() const;
 
+	// see Polynomial::setUseInverseCache
+	void setUseInverseCache(bool enable);
+	bool getUseInverseCache() const;
+
+	// see Polynomial::setRootFinder
+	void setRootFinder(Polynomial::RootFinder root_finder);
+	Polynomial::RootFinder getRootFinder() const;
+
 #ifndef PYPLUSPLUS
 	data_type&       getData();
 #endif // PYPLUSPLUS
@@ -6,6 +6,7 @@
 #include <boost/serialization/version.hpp>
 #include <boost/serialization/vector.hpp>
 #include <limits>
+#include <memory>
 
 #include <pywrap/compat/macros.hpp>
 
@@ -20,6 +21,18 @@ class Polynomial :
 public:
 	typedef std::vector<float_type> data_type;
 
+	// Root finder used by reverseApply if the inverse cache is not used
+	enum RootFinder {
+		// all roots of the companion matrix via gsl_poly_complex_solve,
+		// exactly one of them has to be in the domain (reference)
+		COMPANION_MATRIX,
+		// Brent's method (safeguarded secant/inverse quadratic interpolation
+		// and bisection) inside a finite domain, without heap allocations.
+		// Expects the polynomial to be monotone on the domain, otherwise any
+		// of the roots in the domain may be returned.
+		BRENT
+	};
+
 	Polynomial(data_type const& coeff = data_type(),
 			float_type const& min = 0.0,
 			float_type const& max = CALIBTIC_DOMAIN_MAX);
@@ -31,6 +44,14 @@ public:
 	virtual float_type
 	reverseApply(float_type const& in, Transformation::OutsideDomainBehavior outside_domain_behavior=Transformation::CLIP) const;
 
+#ifndef PYPLUSPLUS
+	virtual void
+	apply(float_type const* in, float_type* out, size_t n, Transformation::OutsideDomainBehavior outside_domain_behavior=Transformation::CLIP) const;
+
+	virtual void
+	reverseApply(float_type const* in, float_type* out, size_t n, Transformation::OutsideDomainBehavior outside_domain_behavior=Transformation::CLIP) const;
+#endif // PYPLUSPLUS
+
 	// Return real roots found by gsl_poly_complex_solve
 	// @param val: solve for $f(x) = val$
 	std::vector< std::complex<float_type> >
@@ -45,12 +66,26 @@ public:
 	// Returns the degree of the polynomial
 	size_t degree() const;
 
+	// Enables or disables the inverse cache of reverseApply (enabled by default).
+	// The cache is built on first use if the polynomial is strictly monotone
+	// on a finite domain, otherwise the exact solver is used.
+	void setUseInverseCache(bool enable);
+	bool getUseInverseCache() const;
+
+	// Selects the root finder of reverseApply (default: COMPANION_MATRIX).
+	// BRENT falls back to COMPANION_MATRIX if the domain is unbounded, e.g.
+	// the default one, or the polynomial overflows at its bounds.
+	void setRootFinder(RootFinder root_finder);
+	RootFinder getRootFinder() const;
+
 	virtual bool
 	operator== (Transformation const& rhs) const;
 
 	virtual std::ostream&
 	operator<< (std::ostream& os) const;
 
+	virtual size_t hash() const;
+
 	data_type const& getData() const;
 
 #ifndef PYPLUSPLUS
@@ -64,9 +99,42 @@ public:
 		float_type const& min = 0.0,
 		float_type const& max = CALIBTIC_DOMAIN_MAX);
 
+protected:
+	// returns the only real root of $f(x) = val$ within the domain, throws
+	// OutsideDomainException if there is none or more than one
+	float_type find_unique_root(float_type const val) const;
+
+	// The coefficients are those of a polynomial in the solver variable t,
+	// t = x for Polynomial and t = 1/x for NegativePowersPolynomial.
+	// Returns the interval of t corresponding to the domain, false if it is
+	// not finite.
+	virtual bool solver_interval(float_type& lower, float_type& upper) const;
+
+	// maps the solver variable @param t back to x
+	virtual float_type from_solver_variable(float_type const t) const;
+
 private:
+	class InverseCache;
+
+	// solves $f(x) = val$ using @param cache if it is usable, otherwise the
+	// selected root finder
+	float_type solve(float_type const val, InverseCache const* cache) const;
+
+	// returns the inverse cache for the current coefficients and domain,
+	// builds it if necessary, null if the domain is unbounded
+	std::shared_ptr<InverseCache const> inverse_cache() const;
+
+	// the solver_interval if it brackets the roots, false if a bound is as
+	// large as CALIBTIC_DOMAIN_MAX or the polynomial is not finite there
+	bool bracket(float_type& lower, float_type& upper) const;
+
 	data_type mData;
 
+	bool mUseInverseCache;
+	RootFinder mRootFinder;
+	// not serialized, shared between copies since it is never modified
+	mutable std::shared_ptr<InverseCache const> mInverseCache;
+
 	friend class boost::serialization::access;
 	template<typename Archiver>
 	void serialize(Archiver& ar, unsigned int const version)
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+
+#include "calibtic/trafo/Transformation.h"
+
+namespace calibtic {
+namespace trafo {
+
+/// Interning pool for transformations.
+///
+/// intern returns one shared instance for all transformations with the same
+/// type, domain and parameters. Instances are only referenced weakly, they are
+/// removed from the pool when the last user releases them. Interned
+/// transformations are shared between their users and must not be modified.
+class Pool
+{
+public:
+	typedef boost::shared_ptr<Transformation> trafo_ptr;
+
+	Pool();
+
+	/// returns the pooled instance equal to @param trafo, if there is none
+	/// @param trafo is added and returned, null is returned as is
+	trafo_ptr intern(trafo_ptr const& trafo);
+
+	/// number of pooled instances that are still in use
+	size_t size() const;
+
+	void clear();
+
+	/// true if @param lhs and @param rhs can be used interchangeably
+	static bool equivalent(Transformation const& lhs, Transformation const& rhs);
+
+private:
+	typedef std::unordered_multimap<size_t, boost::weak_ptr<Transformation> > pool_type;
+
+	/// removes entries of released instances
+	void purge();
+
+	mutable std::mutex mMutex;
+	pool_type mPool;
+
+	/// pool size that triggers the next purge
+	size_t mPurgeSize;
+};
+
+} // trafo
+} // calibtic
@@ -14,6 +14,7 @@
 #include "calibtic/config.h"
 
 #include "calibtic/trafo/Transformation.h"
+#include "calibtic/trafo/Program.h"
 
 namespace calibtic {
 namespace trafo {
@@ -37,10 +38,23 @@ public:
 
 	float_type reverseApply(float_type const& in, Transformation::OutsideDomainBehavior outside_domain_behavior=Transformation::CLIP) const;
 
+#ifndef PYPLUSPLUS
+	void apply(float_type const* in, float_type* out, size_t n, Transformation::OutsideDomainBehavior outside_domain_behavior=Transformation::CLIP) const;
+
+	void reverseApply(float_type const* in, float_type* out, size_t n, Transformation::OutsideDomainBehavior outside_domain_behavior=Transformation::CLIP) const;
+#endif // PYPLUSPLUS
+
 	bool operator== (Transformation const& rhs) const;
 
 	std::ostream& operator<< (std::ostream& os) const;
 
+	size_t hash() const;
+
+	double getPower() const;
+
+	/// the base of the power, if null the input value is used
+	trafo_ptr getTrafo() const;
+
 	// factory function for Py++
 	static
 	boost::shared_ptr<PowerOfTrafo> create(double power, trafo_ptr t);
@@ -50,6 +64,11 @@ private:
 	double mPower;
 	trafo_ptr mTrafo;
 
+#ifndef PYPLUSPLUS
+	// program of the batch apply, not serialized
+	ProgramCache mProgram;
+#endif // PYPLUSPLUS
+
 	friend class boost::serialization::access;
 	template<typename Archiver>
 	void serialize(Archiver& ar, unsigned int const)
@@ -58,6 +77,11 @@ private:
 		ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(Transformation)
 			& make_nvp("trafo", mTrafo)
 			& make_nvp("power", mPower);
+#ifndef PYPLUSPLUS
+		if (Archiver::is_loading::value) {
+			mProgram.reset();
+		}
+#endif // PYPLUSPLUS
 	}
 
 
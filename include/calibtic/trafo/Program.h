@@ -0,0 +1,133 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <ostream>
+
+#include <boost/shared_ptr.hpp>
+
+#include "calibtic/config.h"
+#include "calibtic/trafo/Transformation.h"
+
+namespace calibtic {
+namespace trafo {
+
+/// Flat evaluation program compiled from a tree of transformations.
+///
+/// SumOfTrafos, PowerOfTrafo, Polynomial, NegativePowersPolynomial and
+/// Constant nodes are translated into instructions of a small stack machine,
+/// all other transformations are called through their virtual interface. The
+/// results are bit-identical to the apply of the compiled transformation.
+///
+/// Coefficients and domains are read from the compiled transformations when
+/// the program runs, so the program stays valid as long as it holds the tree.
+///
+/// SumOfTrafos and PowerOfTrafo compile themselves once for their batch apply
+/// (see ProgramCache), so nested composites are evaluated chunk by chunk
+/// instead of allocating temporaries for every level.
+class Program
+{
+public:
+	typedef boost::shared_ptr<Transformation const> trafo_ptr;
+
+	explicit Program(trafo_ptr const& trafo);
+
+	/// same as apply of the compiled transformation
+	float_type apply(float_type const& in,
+	                 Transformation::OutsideDomainBehavior outside_domain_behavior =
+	                     Transformation::CLIP) const;
+
+#ifndef PYPLUSPLUS
+	/// same as the batch apply of the compiled transformation, the values are
+	/// processed in chunks that stay in the cache
+	void apply(float_type const* in, float_type* out, size_t n,
+	           Transformation::OutsideDomainBehavior outside_domain_behavior =
+	               Transformation::CLIP) const;
+#endif // PYPLUSPLUS
+
+	/// number of instructions
+	size_t size() const;
+
+	std::ostream& operator<< (std::ostream& os) const;
+
+	// factory function for Py++
+	static
+	boost::shared_ptr<Program> create(trafo_ptr const& trafo);
+
+private:
+	enum OpCode {
+		CHECK_NONZERO,   //!< input check of the NegativePowersPolynomial node
+		CLIP_DOMAIN,     //!< clip top to the domain of the node
+		PUSH_ZERO,       //!< push 0
+		PUSH_SECOND,     //!< push a copy of the value below top
+		ADD,             //!< pop top and add it to the new top
+		POP_SECOND,      //!< remove the value below top
+		POWER,           //!< top = pow(top, power)
+		CONSTANT,        //!< top = value of the Constant node
+		POLYNOMIAL,      //!< top = Polynomial node applied to top
+		NEGATIVE_POWERS, //!< top = NegativePowersPolynomial node applied to top
+		CALL,            //!< top = node->apply(top), virtual call
+	};
+
+	struct Instruction
+	{
+		OpCode op;
+		Transformation const* node;
+		float_type power;
+	};
+
+	/// @param root selects whether @param trafo is the compiled
+	/// transformation, its domain is handled by the callers behavior
+	void compile(Transformation const& trafo, bool root);
+
+	void emit(OpCode op, Transformation const* node, float_type power = 0.);
+
+	trafo_ptr mTrafo;
+
+	/// how the domain of the compiled transformation is handled
+	enum RootDomain {
+		ROOT_RESPECT_DOMAIN, //!< before the first instruction
+		ROOT_IGNORE_DOMAIN,  //!< not at all, e.g. for Constant
+		ROOT_CALL            //!< by the called transformation
+	};
+	RootDomain mRootDomain;
+
+	/// the compiled transformation is a NegativePowersPolynomial, whose input
+	/// is checked before its domain is handled
+	bool mCheckRootNonZero;
+
+	std::vector<Instruction> mInstructions;
+
+	/// stack depth during compilation and its maximum
+	size_t mDepth;
+	size_t mMaxDepth;
+};
+
+std::ostream& operator<< (std::ostream& os, Program const& p);
+
+#ifndef PYPLUSPLUS
+/// Program of a composite transformation, compiled on first use.
+///
+/// The program refers to the transformation holding the cache, so copies
+/// start empty. The owner has to reset the cache whenever its structure
+/// changes, e.g. on deserialization. Children that are replaced in place
+/// (e.g. a nested SumOfTrafos that is loaded again) are not noticed.
+class ProgramCache
+{
+public:
+	ProgramCache() {}
+	ProgramCache(ProgramCache const&) {}
+	ProgramCache& operator= (ProgramCache const&);
+
+	/// the program of @param owner, compiled if necessary
+	std::shared_ptr<Program const> get(Transformation const& owner) const;
+
+	void reset();
+
+private:
+	mutable std::shared_ptr<Program const> mProgram;
+};
+#endif // PYPLUSPLUS
+
+} // trafo
+} // calibtic
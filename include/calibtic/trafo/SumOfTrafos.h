@@ -14,6 +14,7 @@
 #include "calibtic/config.h"
 
 #include "calibtic/trafo/Transformation.h"
+#include "calibtic/trafo/Program.h"
 
 namespace calibtic {
 namespace trafo {
@@ -35,11 +36,21 @@ public:
 
 	float_type reverseApply(float_type const& in, Transformation::OutsideDomainBehavior outside_domain_behavior=Transformation::CLIP) const;
 
+#ifndef PYPLUSPLUS
+	void apply(float_type const* in, float_type* out, size_t n, Transformation::OutsideDomainBehavior outside_domain_behavior=Transformation::CLIP) const;
+
+	void reverseApply(float_type const* in, float_type* out, size_t n, Transformation::OutsideDomainBehavior outside_domain_behavior=Transformation::CLIP) const;
+#endif // PYPLUSPLUS
+
 	/// Also the order of the lhs's and rhs's transformations is compared.
 	bool operator== (Transformation const& rhs) const;
 
 	std::ostream& operator<< (std::ostream& os) const;
 
+	size_t hash() const;
+
+	trafo_list const& getTrafos() const;
+
 	// factory function for Py++
 	static
 	boost::shared_ptr<SumOfTrafos> create(trafo_list const& trafos);
@@ -48,6 +59,11 @@ private:
 
     trafo_list mTrafos;
 
+#ifndef PYPLUSPLUS
+	// program of the batch apply, not serialized
+	ProgramCache mProgram;
+#endif // PYPLUSPLUS
+
 	friend class boost::serialization::access;
 	template<typename Archiver>
 	void serialize(Archiver& ar, unsigned int const)
@@ -55,6 +71,11 @@ private:
 		using namespace boost::serialization;
 		ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(Transformation)
 			& make_nvp("trafos", mTrafos);
+#ifndef PYPLUSPLUS
+		if (Archiver::is_loading::value) {
+			mProgram.reset();
+		}
+#endif // PYPLUSPLUS
 	}
 
 
@@ -56,6 +56,28 @@ public:
 	    float_type const& in,
 	    OutsideDomainBehavior outside_domain_behavior = CLIP) const = 0;
 
+	/// applies the transformation to the @param n values starting at @param in
+	/// and stores the results in @param out, which may be identical to @param in.
+	/// The domain is handled as in the single value version, but the behavior
+	/// is dispatched once per batch.
+	//
+	//  the default implementation falls back to the single value version,
+	//  derived classes override it with a tight loop
+	virtual void apply(
+	    float_type const* in,
+	    float_type* out,
+	    size_t n,
+	    OutsideDomainBehavior outside_domain_behavior = CLIP) const;
+
+	/// applies the transformation in reverse to the @param n values starting at
+	/// @param in and stores the results in @param out, which may be identical
+	/// to @param in.
+	virtual void reverseApply(
+	    float_type const* in,
+	    float_type* out,
+	    size_t n,
+	    OutsideDomainBehavior outside_domain_behavior = CLIP) const;
+
 	// operator== needs to be removed for code generation, otherwise #!&($-PY++
 	// will emit code, which tries to instantiate this abstract class.
 	virtual bool
@@ -83,11 +105,25 @@ public:
 	float_type respectReverseDomain(float_type val,
 	                                OutsideDomainBehavior outside_domain_behavior) const;
 
+	/// batch version of respectDomain, clipped values are reported by a
+	/// single warning
+	void respectDomain(float_type const* in, float_type* out, size_t n,
+	                   OutsideDomainBehavior outside_domain_behavior) const;
+
+	/// batch version of respectReverseDomain, clipped values are reported by a
+	/// single warning
+	void respectReverseDomain(float_type const* in, float_type* out, size_t n,
+	                          OutsideDomainBehavior outside_domain_behavior) const;
+
 #endif // PYPLUSPLUS
 
 	virtual std::ostream&
 	operator<< (std::ostream& os) const = 0;
 
+	/// hash of type, domain and parameters, equal for transformations that
+	/// compare equal and have the same domain
+	virtual size_t hash() const;
+
 	/// sets the domain and also calculates and sets the reverse domain
 	void setDomain(float_type min, float_type max);
 
@@ -112,6 +148,12 @@ private:
 	                             OutsideDomainBehavior outside_domain_behavior,
 	                             const domain_type& domain) const;
 
+#ifndef PYPLUSPLUS
+	void respectDomainImpl(float_type const* in, float_type* out, size_t n,
+	                       OutsideDomainBehavior outside_domain_behavior,
+	                       const domain_type& domain) const;
+#endif // PYPLUSPLUS
+
 	friend class boost::serialization::access;
 	template<typename Archiver>
 	void serialize(Archiver& ar, unsigned int const version) {
@@ -1,18 +1,105 @@
 #pragma once
+#include <array>
+#include <cstdint>
 #include <random>
+#include <type_traits>
 
 namespace calibtic {
 
-template<typename OutputType, typename InputType>
-OutputType stochastic_round(InputType input)
+/// Counter-based random number generator Philox4x32-10 (Salmon et al., "Parallel
+/// random numbers: as easy as 1, 2, 3", SC 2011).
+///
+/// Each output block is a pure function of key and counter, there is no hidden
+/// state. Generators constructed with the same seed and stream produce the same
+/// numbers, independent of the thread they run in, which makes one generator
+/// per element (e.g. per synapse) cheap, race-free and reproducible.
+class Philox4x32
+{
+public:
+	typedef uint32_t result_type;
+	typedef std::array<uint32_t, 4> counter_type;
+	typedef std::array<uint32_t, 2> key_type;
+
+	/// @param seed is the key, @param stream selects one of 2^64 independent
+	/// sequences of 2^64 blocks each
+	explicit Philox4x32(uint64_t const seed = 0, uint64_t const stream = 0) :
+		mKey{{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)}},
+		mCounter{{0, 0, static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32)}},
+		mBuffer(),
+		mIndex(4)
+	{}
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return 0xffffffff; }
+
+	result_type operator()()
+	{
+		if (mIndex == 4) {
+			mBuffer = block(mCounter, mKey);
+			if (++mCounter[0] == 0) {
+				++mCounter[1];
+			}
+			mIndex = 0;
+		}
+		return mBuffer[mIndex++];
+	}
+
+	/// the Philox4x32-10 bijection of @param counter under @param key
+	static counter_type block(counter_type counter, key_type key)
+	{
+		for (size_t round = 0; round < 10; ++round) {
+			if (round > 0) {
+				key[0] += 0x9E3779B9;
+				key[1] += 0xBB67AE85;
+			}
+			uint64_t const p0 = uint64_t(0xD2511F53) * counter[0];
+			uint64_t const p1 = uint64_t(0xCD9E8D57) * counter[2];
+			counter = {{static_cast<uint32_t>(p1 >> 32) ^ counter[1] ^ key[0],
+			            static_cast<uint32_t>(p1),
+			            static_cast<uint32_t>(p0 >> 32) ^ counter[3] ^ key[1],
+			            static_cast<uint32_t>(p0)}};
+		}
+		return counter;
+	}
+
+private:
+	key_type mKey;
+	counter_type mCounter;
+	counter_type mBuffer;
+	size_t mIndex;
+};
+
+/// uniformly distributed double in [0, 1) from two outputs of the 32 bit
+/// generator @param gen. Unlike std::generate_canonical, the result does not
+/// depend on the standard library.
+template<typename Engine>
+double canonical(Engine& gen)
+{
+	static_assert(Engine::min() == 0 && Engine::max() == 0xffffffff,
+	              "32 bit generator required");
+	uint64_t const high = static_cast<uint32_t>(gen()) >> 5;
+	uint64_t const low = static_cast<uint32_t>(gen()) >> 6;
+	return static_cast<double>((high << 26) | low) * (1. / 9007199254740992.);
+}
+
+/// same as below, the random number is drawn from @param gen
+template<typename OutputType, typename InputType, typename Engine>
+OutputType stochastic_round(InputType input, Engine& gen)
 {
 	static_assert(std::is_floating_point<InputType>::value,
 				  "input must be floating point");
-	static std::mt19937 gen;
-	return std::generate_canonical<InputType>(gen) < input-static_cast<OutputType>(input) ?
+	return canonical(gen) < input-static_cast<OutputType>(input) ?
 		++input : input;
 }
 
+/// not thread-safe, all callers share one generator
+template<typename OutputType, typename InputType>
+OutputType stochastic_round(InputType input)
+{
+	static std::mt19937 gen;
+	return stochastic_round<OutputType>(input, gen);
+}
+
 
 template<typename T>
 T clip(T val, T min, T max)
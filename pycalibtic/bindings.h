@@ -27,6 +27,7 @@
 #include "calibtic/HMF/HWNeuronParameter.h"
 #include "calibtic/HMF/HWSharedParameter.h"
 #include "calibtic/HMF/ADC/ADCCalibration.h"
+#include "calibtic/HMF/ADC/LUTADCCalibration.h"
 #include "calibtic/HMF/SynapseCalibration.h"
 #include "calibtic/HMF/GmaxConfig.h"
 #include "calibtic/HMF/SynapseRowCalibration.h"
@@ -29,7 +29,7 @@ shared_ptr_class_factories = [
     'NeuronCalibration', 'SharedCalibration', 'ADCCalibration',
     'NeuronCollection', 'BlockCollection', 'HICANNCollection',
     'SynapseCalibration', 'SynapseRowCalibration',  'SynapseRowCollection',
-    'STPUtilizationCalibration', 'QuadraticADCCalibration',
+    'STPUtilizationCalibration', 'QuadraticADCCalibration', 'LUTADCCalibration',
     'L1CrossbarCollection', 'L1CrossbarCalibration',
     'SynapseChainLengthCollection', 'SynapseChainLengthCalibration',
     'SynapseSwitchCollection', 'SynapseSwitchCalibration',
@@ -74,6 +74,9 @@ cls = [
     'NeuronCalibrationParameters',
     'VoltageMeasurement',
     'DataPoint',
+    'TraceStatistics',
+    'PolynomialFit',
+    'PolynomialFitter',
 ]
 
 ns.include(mb, 'classes', cls)
@@ -1,10 +1,12 @@
 #include "calibtic/HMF/ADC/ADCCalibration.h"
 
+#include <algorithm>
+#include <array>
 #include <sstream>
+#include <stdexcept>
 #include <memory>
 #include <cmath>
 #include <boost/make_shared.hpp>
-#include <gsl/gsl_multifit.h>
 #include <log4cxx/logger.h>
 
 #include "calibtic/trafo/Polynomial.h"
@@ -12,6 +14,7 @@
 #include "halco/common/iter_all.h"
 #include "halco/hicann/v2/external.h"
 #include "calibtic/HMF/ADC/QuadraticADCCalibration.h"
+#include "calibtic/HMF/ADC/LUTADCCalibration.h"
 
 namespace HMF {
 namespace ADC {
@@ -64,97 +67,176 @@ std::vector<float>
 ADCCalibration::apply(key_type channel, std::vector<uint16_t> const& data) const
 {
 	std::vector<float> voltages (data.size());
+	apply(channel, data.data(), voltages.data(), data.size());
+	return voltages;
+}
+
+pyublas::numpy_vector<float>
+ADCCalibration::apply(key_type channel, pyublas::numpy_vector<uint16_t> const& data) const
+{
+	pyublas::numpy_vector<float> voltages (data.size());
+	if (data.size() > 0) {
+		apply(channel, &*data.begin(), &*voltages.begin(), data.size());
+	} else if (!isComplete()) {
+		throw std::runtime_error("invalid ADC Calibration");
+	}
+	return voltages;
+}
+
+void ADCCalibration::apply(
+	key_type channel, std::vector<uint16_t> const& data,
+	std::vector<float>& out) const
+{
+	out.resize(data.size());
+	apply(channel, data.data(), out.data(), data.size());
+}
+
+void ADCCalibration::apply(
+	key_type channel, pyublas::numpy_vector<uint16_t> const& data,
+	pyublas::numpy_vector<float> out) const
+{
+	if (out.size() < data.size()) {
+		std::stringstream err;
+		err << "ADCCalibration: output array holds " << out.size()
+		    << " elements, " << data.size() << " are required";
+		throw std::length_error(err.str());
+	}
+
+	if (data.size() > 0) {
+		apply(channel, &*data.begin(), &*out.begin(), data.size());
+	} else if (!isComplete()) {
+		throw std::runtime_error("invalid ADC Calibration");
+	}
+}
 
-	const_value_type trafo;
+TraceStatistics ADCCalibration::statistics(
+	key_type channel, std::vector<uint16_t> const& data, TraceStatistics stats) const
+{
+	accumulate(channel, data.data(), data.size(), stats);
+	return stats;
+}
+
+TraceStatistics ADCCalibration::statistics(
+	key_type channel, pyublas::numpy_vector<uint16_t> const& data, TraceStatistics stats) const
+{
+	if (data.size() > 0) {
+		accumulate(channel, &*data.begin(), data.size(), stats);
+	} else if (!isComplete()) {
+		throw std::runtime_error("invalid ADC Calibration");
+	}
+	return stats;
+}
+
+void ADCCalibration::accumulate(
+	key_type channel, uint16_t const* data, size_t const n,
+	TraceStatistics& stats) const
+{
 	if (!isComplete()) {
 		throw std::runtime_error("invalid ADC Calibration");
 	}
 
-	for(auto const& it : zip(data, voltages)) {
-		applyOne(it.first, it.second, channel);
+	// converted samples only live in this L1-sized block
+	size_t const block = 1024;
+	std::array<float, block> voltages;
+	for (size_t begin = 0; begin < n; begin += block) {
+		size_t const size = std::min(block, n - begin);
+		apply(channel, data + begin, voltages.data(), size);
+		stats.push(voltages.data(), size);
 	}
-	return voltages;
 }
 
-pyublas::numpy_vector<float>
-ADCCalibration::apply(key_type channel, pyublas::numpy_vector<uint16_t> const& data) const
+size_t ADCCalibration::applyChunked(
+	key_type channel, source_function const& source, sink_function const& sink,
+	size_t const chunk) const
 {
-	pyublas::numpy_vector<float> voltages (data.size());
+	if (chunk == 0) {
+		throw std::invalid_argument("ADCCalibration: chunk size must be positive");
+	}
 
-	const_value_type trafo;
+	std::vector<uint16_t> raw;
+	raw.reserve(chunk);
+	std::vector<float> voltages(chunk);
+	size_t total = 0;
+	for (;;) {
+		raw.clear();
+		source(raw, chunk);
+		size_t const n = raw.size();
+		if (n == 0) {
+			break;
+		}
+		if (n > chunk) {
+			throw std::length_error("ADCCalibration: source exceeded the chunk size");
+		}
+		apply(channel, raw.data(), voltages.data(), n);
+		sink(voltages.data(), n);
+		total += n;
+	}
+	return total;
+}
+
+void ADCCalibration::apply(
+	key_type channel, uint16_t const* data, float* out, size_t const n) const
+{
 	if (!isComplete()) {
 		throw std::runtime_error("invalid ADC Calibration");
 	}
 
-	for(auto const& it : zip(data, voltages)) {
-		applyOne(it.first, it.second, channel);
+	// converted in blocks, so the intermediate buffer stays in the L1 cache
+	// and is not allocated per call
+	size_t const block = 1024;
+	std::array<calibtic::float_type, block> buffer;
+	for (size_t begin = 0; begin < n; begin += block) {
+		size_t const size = std::min(block, n - begin);
+		std::copy(data + begin, data + begin + size, buffer.begin());
+		applyMany(buffer.data(), buffer.data(), size, channel);
+		std::copy(buffer.begin(), buffer.begin() + size, out + begin);
 	}
-	return voltages;
 }
 
-void ADCCalibration::makePolynomialTrafo(
+PolynomialFit ADCCalibration::makePolynomialTrafo(
 	Calibration::key_type offset,
 	VoltageMeasurement const& voltage,
 	unsigned const order)
 {
-	// ugly C-style GSL weighted polynomial fitting, for more details see:
-	// http://www.gnu.org/software/gsl/manual/html_node/Fitting-Examples.html
-	size_t const n = voltage.size();
-	size_t const n_coeff = order + 1;
+	// keeps the workspace between calls of the same thread
+	thread_local PolynomialFitter fitter;
 
-	if (n < n_coeff) {
-		throw std::runtime_error(
-			"Order of polynomial has to be < #data points.");
-	}
-
-	typedef std::shared_ptr<gsl_matrix> mat;
-	auto make_matrix = [](size_t n, size_t m) {
-		return mat(gsl_matrix_alloc (n, m),
-				   [](gsl_matrix* m) { gsl_matrix_free(m); }); };
-
-	typedef std::shared_ptr<gsl_vector> vec;
-	auto make_vector = [](size_t n) {
-		return vec(gsl_vector_alloc(n),
-				   [](gsl_vector* v) { gsl_vector_free(v); }); };
-
-	double chisq;
-	mat X = make_matrix(n, n_coeff);
-	vec y = make_vector(n);
-	vec w = make_vector(n);
-	vec c = make_vector(n_coeff);
-	mat cov = make_matrix(n_coeff, n_coeff);
-
-	size_t cnt = 0;
-	for (auto const& point : voltage.data())
-	{
-		gsl_matrix_set(X.get(), cnt, 0, 1.0);
-		for (size_t ii = 1; ii< n_coeff; ++ii) {
-			gsl_matrix_set(X.get(), cnt, ii, pow(point.mean, ii));
-		}
+	PolynomialFit fit = fitter.fit(voltage, order);
 
-		gsl_vector_set(y.get(), cnt, point.ref);
+	assert(size() == 8);
+	reset(offset, calibtic::trafo::Polynomial::create(fit.coefficients));
+	return fit;
+}
 
-		// weight measurement points with big error less
-		gsl_vector_set(w.get(), cnt, 1.0/(pow(point.std, 2)));
+std::vector<PolynomialFit> ADCCalibration::makePolynomialTrafos(
+	std::vector<VoltageMeasurement> const& voltages,
+	unsigned const order)
+{
+	thread_local PolynomialFitter fitter;
+	return makePolynomialTrafos(voltages, order, fitter);
+}
 
-		++cnt;
+std::vector<PolynomialFit> ADCCalibration::makePolynomialTrafos(
+	std::vector<VoltageMeasurement> const& voltages,
+	unsigned const order,
+	PolynomialFitter& fitter)
+{
+	if (voltages.size() != size()) {
+		std::stringstream err;
+		err << "ADCCalibration: " << voltages.size() << " measurements for "
+		    << size() << " channels";
+		throw std::runtime_error(err.str());
 	}
 
-	// do the fit
-	gsl_multifit_linear_workspace* work =
-		gsl_multifit_linear_alloc(n, n_coeff);
-	gsl_multifit_wlinear(X.get(), w.get(), y.get(), c.get(),
-						 cov.get(), &chisq, work);
-	gsl_multifit_linear_free(work);
-
-
-	calibtic::trafo::Polynomial::data_type coeff;
-	for (size_t ii = 0; ii<n_coeff; ++ii) {
-		coeff.push_back(gsl_vector_get(c.get(), (ii)));
+	std::vector<PolynomialFit> fits(voltages.size());
+	for (size_t offset = 0; offset < voltages.size(); ++offset) {
+		fitter.fit(voltages[offset], order, fits[offset]);
 	}
 
-	assert(size() == 8);
-	reset(offset, calibtic::trafo::Polynomial::create(coeff));
+	for (size_t offset = 0; offset < fits.size(); ++offset) {
+		reset(offset, calibtic::trafo::Polynomial::create(fits[offset].coefficients));
+	}
+	return fits;
 }
 
 std::ostream& ADCCalibration::operator<< (std::ostream& os) const
@@ -211,6 +293,18 @@ ADCCalibration::convertToQuadraticADCCalibration(const ADCCalibration & other)
 
 }
 
+boost::shared_ptr<LUTADCCalibration>
+ADCCalibration::convertToLUTADCCalibration(const ADCCalibration & other, unsigned const bits)
+{
+	if (!other.isComplete()) {
+		throw std::runtime_error("Cannot convert incomplete ADCCalibration.");
+	}
+
+	boost::shared_ptr<LUTADCCalibration> lut = boost::make_shared<LUTADCCalibration>(bits);
+	lut->Calibration::copy(other);
+	return lut;
+}
+
 bool ADCCalibration::isComplete() const
 {
 	if (size() != static_cast<size_t>(key_type::end))
@@ -0,0 +1,113 @@
+#include "calibtic/HMF/ADC/LUTADCCalibration.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace HMF {
+namespace ADC {
+
+LUTADCCalibration::LUTADCCalibration(unsigned const bits) :
+	mBits(bits)
+{
+	if (bits == 0 || bits > 16) {
+		throw std::invalid_argument("LUTADCCalibration: bits must be in [1, 16]");
+	}
+}
+
+LUTADCCalibration::~LUTADCCalibration()
+{}
+
+unsigned LUTADCCalibration::getBits() const
+{
+	return mBits;
+}
+
+std::shared_ptr<LUTADCCalibration::Table const>
+LUTADCCalibration::table(key_type const channel) const
+{
+	std::shared_ptr<Table const>& cached = mTables.at(channel);
+	std::shared_ptr<Table const> table = std::atomic_load(&cached);
+	if (!table || table->trafo != mTrafo.at(channel)) {
+		auto fresh = std::make_shared<Table>();
+		fresh->trafo = mTrafo[channel];
+
+		// only samples inside the domain are tabulated, the others are
+		// clipped or rejected by the transformation on each conversion
+		calibtic::domain_type const domain = fresh->trafo->getDomain();
+		size_t first = 0;
+		size_t end = size_t(1) << mBits;
+		while (first < end && !boost::icl::contains(domain, calibtic::float_type(first))) {
+			++first;
+		}
+		while (end > first && !boost::icl::contains(domain, calibtic::float_type(end - 1))) {
+			--end;
+		}
+		fresh->first = first;
+
+		std::vector<calibtic::float_type> buffer(end - first);
+		std::iota(buffer.begin(), buffer.end(), calibtic::float_type(first));
+		applyMany(buffer.data(), buffer.data(), buffer.size(), channel);
+		fresh->voltages.assign(buffer.begin(), buffer.end());
+
+		table = fresh;
+		std::atomic_store(&cached, table);
+	}
+	return table;
+}
+
+void LUTADCCalibration::apply(
+	key_type channel, uint16_t const* data, float* out, size_t const n) const
+{
+	if (!isComplete()) {
+		throw std::runtime_error("invalid ADC Calibration");
+	}
+
+	std::shared_ptr<Table const> const table = this->table(channel);
+	float const* const voltages = table->voltages.data();
+	size_t const first = table->first;
+	size_t const size = table->voltages.size();
+
+	if (first == 0 && size > std::numeric_limits<uint16_t>::max()) {
+		for (size_t ii = 0; ii < n; ++ii) {
+			out[ii] = voltages[data[ii]];
+		}
+		return;
+	}
+
+	for (size_t ii = 0; ii < n; ++ii) {
+		// wraps around for samples below the table
+		size_t const index = size_t(data[ii]) - first;
+		if (index < size) {
+			out[ii] = voltages[index];
+		} else {
+			calibtic::float_type voltage = data[ii];
+			applyMany(&voltage, &voltage, 1, channel);
+			out[ii] = voltage;
+		}
+	}
+}
+
+void LUTADCCalibration::clearTables()
+{
+	for (auto& table : mTables) {
+		std::atomic_store(&table, std::shared_ptr<Table const>());
+	}
+}
+
+std::ostream& LUTADCCalibration::operator<< (std::ostream& os) const
+{
+	os << "LUTADCCalibration (" << mBits << " bit): ";
+	return Calibration::operator<<(os);
+}
+
+// Py++ factory function
+boost::shared_ptr<LUTADCCalibration> LUTADCCalibration::create(unsigned const bits)
+{
+	return boost::shared_ptr<LUTADCCalibration>(new LUTADCCalibration(bits));
+}
+
+} // ADC
+} // HMF
@@ -0,0 +1,273 @@
+#include "calibtic/HMF/ADC/PolynomialFitter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <gsl/gsl_multifit.h>
+
+namespace HMF {
+namespace ADC {
+
+/// buffers of the last fit, reallocated only when the size changes
+class PolynomialFitter::Workspace
+{
+public:
+	Workspace() :
+		n(0), n_coeff(0),
+		X(nullptr), y(nullptr), w(nullptr), c(nullptr), cov(nullptr), work(nullptr)
+	{}
+
+	~Workspace()
+	{
+		free();
+	}
+
+	void resize(size_t const new_n, size_t const new_n_coeff)
+	{
+		if (new_n == n && new_n_coeff == n_coeff) {
+			return;
+		}
+		free();
+		n = new_n;
+		n_coeff = new_n_coeff;
+		X = gsl_matrix_alloc(n, n_coeff);
+		y = gsl_vector_alloc(n);
+		w = gsl_vector_alloc(n);
+		c = gsl_vector_alloc(n_coeff);
+		cov = gsl_matrix_alloc(n_coeff, n_coeff);
+		work = gsl_multifit_linear_alloc(n, n_coeff);
+	}
+
+	size_t n;
+	size_t n_coeff;
+
+	gsl_matrix* X;
+	gsl_vector* y;
+	gsl_vector* w;
+	gsl_vector* c;
+	gsl_matrix* cov;
+	gsl_multifit_linear_workspace* work;
+
+	// normal equations
+	std::vector<double> moments;
+	std::vector<double> rhs;
+	std::vector<double> cholesky;
+	std::vector<double> column;
+
+private:
+	void free()
+	{
+		if (work) {
+			gsl_multifit_linear_free(work);
+			gsl_matrix_free(cov);
+			gsl_vector_free(c);
+			gsl_vector_free(w);
+			gsl_vector_free(y);
+			gsl_matrix_free(X);
+		}
+		work = nullptr;
+		n = n_coeff = 0;
+	}
+
+	Workspace(Workspace const&);
+	Workspace& operator=(Workspace const&);
+};
+
+namespace {
+
+/// solves L L^T x = b in place for the lower triangular, row-major @param L
+void cholesky_solve(std::vector<double> const& L, size_t const p, double* x)
+{
+	for (size_t ii = 0; ii < p; ++ii) {
+		for (size_t kk = 0; kk < ii; ++kk) {
+			x[ii] -= L[ii * p + kk] * x[kk];
+		}
+		x[ii] /= L[ii * p + ii];
+	}
+	for (size_t ii = p; ii-- > 0;) {
+		for (size_t kk = ii + 1; kk < p; ++kk) {
+			x[ii] -= L[kk * p + ii] * x[kk];
+		}
+		x[ii] /= L[ii * p + ii];
+	}
+}
+
+} // namespace
+
+PolynomialFitter::PolynomialFitter(Method const method) :
+	mMethod(method),
+	mWorkspace(new Workspace())
+{
+}
+
+PolynomialFitter::~PolynomialFitter()
+{
+}
+
+PolynomialFitter::Method PolynomialFitter::getMethod() const
+{
+	return mMethod;
+}
+
+PolynomialFit PolynomialFitter::fit(VoltageMeasurement const& voltage, unsigned const order)
+{
+	PolynomialFit result;
+	fit(voltage, order, result);
+	return result;
+}
+
+void PolynomialFitter::fit(
+	VoltageMeasurement const& voltage, unsigned const order, PolynomialFit& result)
+{
+	size_t const n = voltage.size();
+	size_t const n_coeff = order + 1;
+
+	if (n < n_coeff) {
+		throw std::runtime_error(
+			"Order of polynomial has to be < #data points.");
+	}
+
+	result.coefficients.resize(n_coeff);
+	result.covariance.resize(n_coeff * n_coeff);
+	result.points = n;
+
+	switch (mMethod) {
+		case NORMAL_EQUATIONS:
+			fitNormalEquations(voltage, n_coeff, result);
+			break;
+		default:
+			fitGSL(voltage, n_coeff, result);
+	}
+}
+
+void PolynomialFitter::fitGSL(
+	VoltageMeasurement const& voltage, size_t const n_coeff, PolynomialFit& result)
+{
+	// for more details see:
+	// http://www.gnu.org/software/gsl/manual/html_node/Fitting-Examples.html
+	Workspace& ws = *mWorkspace;
+	ws.resize(voltage.size(), n_coeff);
+
+	size_t cnt = 0;
+	for (auto const& point : voltage.data())
+	{
+		// Vandermonde row, powers built incrementally
+		double power = 1.0;
+		for (size_t ii = 0; ii < n_coeff; ++ii) {
+			gsl_matrix_set(ws.X, cnt, ii, power);
+			power *= point.mean;
+		}
+
+		gsl_vector_set(ws.y, cnt, point.ref);
+
+		// weight measurement points with big error less
+		gsl_vector_set(ws.w, cnt, 1.0/(double(point.std) * point.std));
+
+		++cnt;
+	}
+
+	gsl_multifit_wlinear(ws.X, ws.w, ws.y, ws.c, ws.cov, &result.chisq, ws.work);
+
+	for (size_t ii = 0; ii < n_coeff; ++ii) {
+		result.coefficients[ii] = gsl_vector_get(ws.c, ii);
+		for (size_t jj = 0; jj < n_coeff; ++jj) {
+			result.covariance[ii * n_coeff + jj] = gsl_matrix_get(ws.cov, ii, jj);
+		}
+	}
+}
+
+void PolynomialFitter::fitNormalEquations(
+	VoltageMeasurement const& voltage, size_t const n_coeff, PolynomialFit& result)
+{
+	Workspace& ws = *mWorkspace;
+	size_t const p = n_coeff;
+
+	// The fit is done in t = mean / scale with |t| <= 1, which keeps the
+	// condition of the normal equations acceptable for 12 bit ADC values.
+	double scale = 0.;
+	for (auto const& point : voltage.data()) {
+		scale = std::max(scale, std::abs(double(point.mean)));
+	}
+	if (!(scale > 0.) || !std::isfinite(scale)) {
+		scale = 1.;
+	}
+
+	// the normal matrix is a Hankel matrix of the weighted power sums
+	ws.moments.assign(2 * p - 1, 0.);
+	ws.rhs.assign(p, 0.);
+	for (auto const& point : voltage.data()) {
+		double const t = point.mean / scale;
+		double const w = 1.0/(double(point.std) * point.std);
+		double power = w;
+		for (size_t kk = 0; kk < 2 * p - 1; ++kk) {
+			ws.moments[kk] += power;
+			if (kk < p) {
+				ws.rhs[kk] += power * point.ref;
+			}
+			power *= t;
+		}
+	}
+
+	// Cholesky decomposition
+	std::vector<double>& L = ws.cholesky;
+	L.assign(p * p, 0.);
+	for (size_t jj = 0; jj < p; ++jj) {
+		double d = ws.moments[2 * jj];
+		for (size_t kk = 0; kk < jj; ++kk) {
+			d -= L[jj * p + kk] * L[jj * p + kk];
+		}
+		if (!(d > 0.)) {
+			throw std::runtime_error(
+				"PolynomialFitter: normal equations are singular");
+		}
+		L[jj * p + jj] = std::sqrt(d);
+		for (size_t ii = jj + 1; ii < p; ++ii) {
+			double s = ws.moments[ii + jj];
+			for (size_t kk = 0; kk < jj; ++kk) {
+				s -= L[ii * p + kk] * L[jj * p + kk];
+			}
+			L[ii * p + jj] = s / L[jj * p + jj];
+		}
+	}
+
+	// coefficients in t
+	cholesky_solve(L, p, ws.rhs.data());
+
+	double chisq = 0.;
+	for (auto const& point : voltage.data()) {
+		double const t = point.mean / scale;
+		double fitted = ws.rhs[p - 1];
+		for (size_t kk = p - 1; kk-- > 0;) {
+			fitted = fitted * t + ws.rhs[kk];
+		}
+		double const residual = point.ref - fitted;
+		chisq += residual * residual / (double(point.std) * point.std);
+	}
+	result.chisq = chisq;
+
+	// covariance is the inverse of the normal matrix, column by column
+	ws.column.resize(p);
+	for (size_t jj = 0; jj < p; ++jj) {
+		std::fill(ws.column.begin(), ws.column.end(), 0.);
+		ws.column[jj] = 1.;
+		cholesky_solve(L, p, ws.column.data());
+		for (size_t ii = 0; ii < p; ++ii) {
+			result.covariance[ii * p + jj] = ws.column[ii];
+		}
+	}
+
+	// back to powers of mean: c_i = c'_i / scale^i
+	double power_i = 1.;
+	for (size_t ii = 0; ii < p; ++ii) {
+		result.coefficients[ii] = ws.rhs[ii] / power_i;
+		double power_j = 1.;
+		for (size_t jj = 0; jj < p; ++jj) {
+			result.covariance[ii * p + jj] /= power_i * power_j;
+			power_j *= scale;
+		}
+		power_i *= scale;
+	}
+}
+
+} // ADC
+} // HMF
@@ -10,6 +10,19 @@
 #include "halco/common/iter_all.h"
 #include "halco/hicann/v2/external.h"
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CALIBTIC_ADC_X86
+#endif
+
+// Multiplication and addition must not be fused, otherwise the result would
+// depend on the kernel that happened to be used.
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
 namespace HMF {
 namespace ADC {
 
@@ -31,33 +44,133 @@ QuadraticADCCalibration::~QuadraticADCCalibration()
 }
 
 namespace {
-	template<typename ResultType, typename InType>
-	inline ResultType apply_impl(const QuadraticCoefficients coeffs,
-			                     InType const& data)
-	{
-		ResultType result(data.size());
-		typename ResultType::iterator out = result.begin();
-		for(auto it = data.begin(); it != data.end(); ++it, ++out)
-		{
-			typename ResultType::value_type v = *it;
-			*out = (coeffs.a * v +  coeffs.b) * v + coeffs.c;
-		}
-		return result;
+
+// Only the conversion of the sample is vectorized, the polynomial is
+// evaluated in double precision without fused multiply-add just like the
+// scalar loop, so all kernels produce the same floats.
+
+inline float apply_scalar(QuadraticCoefficients const& coeffs, uint16_t const data)
+{
+	double const v = data;
+	return static_cast<float>((coeffs.a * v + coeffs.b) * v + coeffs.c);
+}
+
+void apply_scalar(QuadraticCoefficients const& coeffs,
+                  uint16_t const* data, float* out, size_t const n)
+{
+	for (size_t ii = 0; ii < n; ++ii) {
+		out[ii] = apply_scalar(coeffs, data[ii]);
 	}
 }
 
+#ifdef CALIBTIC_ADC_X86
+
+__attribute__((target("avx2")))
+void apply_avx2(QuadraticCoefficients const& coeffs,
+                uint16_t const* data, float* out, size_t const n)
+{
+	__m256d const a = _mm256_set1_pd(coeffs.a);
+	__m256d const b = _mm256_set1_pd(coeffs.b);
+	__m256d const c = _mm256_set1_pd(coeffs.c);
+
+	size_t ii = 0;
+	for (; ii + 8 <= n; ii += 8) {
+		__m256i const samples = _mm256_cvtepu16_epi32(
+			_mm_loadu_si128(reinterpret_cast<__m128i const*>(data + ii)));
+		__m256d const x0 = _mm256_cvtepi32_pd(_mm256_castsi256_si128(samples));
+		__m256d const x1 = _mm256_cvtepi32_pd(_mm256_extracti128_si256(samples, 1));
+
+		__m256d const r0 = _mm256_add_pd(_mm256_mul_pd(
+			_mm256_add_pd(_mm256_mul_pd(a, x0), b), x0), c);
+		__m256d const r1 = _mm256_add_pd(_mm256_mul_pd(
+			_mm256_add_pd(_mm256_mul_pd(a, x1), b), x1), c);
+
+		_mm_storeu_ps(out + ii, _mm256_cvtpd_ps(r0));
+		_mm_storeu_ps(out + ii + 4, _mm256_cvtpd_ps(r1));
+	}
+
+	apply_scalar(coeffs, data + ii, out + ii, n - ii);
+}
+
+__attribute__((target("avx512f")))
+void apply_avx512(QuadraticCoefficients const& coeffs,
+                  uint16_t const* data, float* out, size_t const n)
+{
+	__m512d const a = _mm512_set1_pd(coeffs.a);
+	__m512d const b = _mm512_set1_pd(coeffs.b);
+	__m512d const c = _mm512_set1_pd(coeffs.c);
+
+	size_t ii = 0;
+	for (; ii + 16 <= n; ii += 16) {
+		__m512i const samples = _mm512_cvtepu16_epi32(
+			_mm256_loadu_si256(reinterpret_cast<__m256i const*>(data + ii)));
+		__m512d const x0 = _mm512_cvtepi32_pd(_mm512_castsi512_si256(samples));
+		__m512d const x1 = _mm512_cvtepi32_pd(_mm512_extracti64x4_epi64(samples, 1));
+
+		__m512d const r0 = _mm512_add_pd(_mm512_mul_pd(
+			_mm512_add_pd(_mm512_mul_pd(a, x0), b), x0), c);
+		__m512d const r1 = _mm512_add_pd(_mm512_mul_pd(
+			_mm512_add_pd(_mm512_mul_pd(a, x1), b), x1), c);
+
+		_mm256_storeu_ps(out + ii, _mm512_cvtpd_ps(r0));
+		_mm256_storeu_ps(out + ii + 8, _mm512_cvtpd_ps(r1));
+	}
+
+	apply_scalar(coeffs, data + ii, out + ii, n - ii);
+}
+
+#endif // CALIBTIC_ADC_X86
+
+} // namespace
+
 std::vector<float>
 QuadraticADCCalibration::apply(
 		key_type channel, std::vector<uint16_t> const& data) const
 {
-	return apply_impl<std::vector<float>>(mCoefficents.at(channel), data);
+	std::vector<float> result(data.size());
+	apply(channel, data.data(), result.data(), data.size());
+	return result;
 }
 
 pyublas::numpy_vector<float>
 QuadraticADCCalibration::apply(
 		key_type channel, pyublas::numpy_vector<uint16_t> const& data) const
 {
-	return apply_impl<pyublas::numpy_vector<float>>(mCoefficents.at(channel), data);
+	pyublas::numpy_vector<float> result(data.size());
+	if (data.size() > 0) {
+		apply(channel, &*data.begin(), &*result.begin(), data.size());
+	}
+	return result;
+}
+
+void QuadraticADCCalibration::apply(
+	key_type channel, uint16_t const* data, float* out, size_t const n) const
+{
+	apply(channel, data, out, n, calibtic::simd::best());
+}
+
+void QuadraticADCCalibration::apply(
+	key_type channel, uint16_t const* data, float* out, size_t const n,
+	calibtic::simd::Kernel const kernel) const
+{
+	if (!calibtic::simd::supported(kernel)) {
+		throw std::runtime_error(
+			"QuadraticADCCalibration: requested kernel not supported by this cpu");
+	}
+
+	QuadraticCoefficients const& coeffs = mCoefficents.at(channel);
+	switch (kernel) {
+#ifdef CALIBTIC_ADC_X86
+		case calibtic::simd::AVX512:
+			apply_avx512(coeffs, data, out, n);
+			break;
+		case calibtic::simd::AVX2:
+			apply_avx2(coeffs, data, out, n);
+			break;
+#endif // CALIBTIC_ADC_X86
+		default:
+			apply_scalar(coeffs, data, out, n);
+	}
 }
 
 std::ostream& QuadraticADCCalibration::operator<< (std::ostream& out) const
@@ -0,0 +1,183 @@
+#include "calibtic/HMF/ADC/TraceStatistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace HMF {
+namespace ADC {
+
+TraceStatistics::TraceStatistics() :
+	TraceStatistics(0, 0., 0.)
+{}
+
+TraceStatistics::TraceStatistics(size_t const bins, double const lower, double const upper) :
+	mCount(0),
+	mMean(0.),
+	mM2(0.),
+	mMin(std::numeric_limits<double>::infinity()),
+	mMax(-std::numeric_limits<double>::infinity()),
+	mLower(lower),
+	mUpper(upper),
+	mHistogram(bins, 0),
+	mUnderflow(0),
+	mOverflow(0)
+{
+	if (bins > 0 && !(lower < upper)) {
+		throw std::invalid_argument("TraceStatistics: empty histogram range");
+	}
+}
+
+void TraceStatistics::push(double const value)
+{
+	++mCount;
+	double const delta = value - mMean;
+	mMean += delta / mCount;
+	mM2 += delta * (value - mMean);
+	mMin = std::min(mMin, value);
+	mMax = std::max(mMax, value);
+	bin(value);
+}
+
+void TraceStatistics::push(float const* values, size_t const n)
+{
+	if (n == 0) {
+		return;
+	}
+
+	// Mean and squared deviations of the block are computed in two passes over
+	// the (cached) block and merged, which is cheaper than one Welford update
+	// per value and at least as accurate.
+	double sum = 0.;
+	double min = std::numeric_limits<double>::infinity();
+	double max = -std::numeric_limits<double>::infinity();
+	for (size_t ii = 0; ii < n; ++ii) {
+		sum += values[ii];
+		min = std::min<double>(min, values[ii]);
+		max = std::max<double>(max, values[ii]);
+	}
+	double const mean = sum / n;
+	double m2 = 0.;
+	for (size_t ii = 0; ii < n; ++ii) {
+		double const delta = values[ii] - mean;
+		m2 += delta * delta;
+	}
+	mergeMoments(n, mean, m2, min, max);
+
+	if (!mHistogram.empty()) {
+		for (size_t ii = 0; ii < n; ++ii) {
+			bin(values[ii]);
+		}
+	}
+}
+
+void TraceStatistics::merge(TraceStatistics const& other)
+{
+	if (other.mHistogram.size() != mHistogram.size() ||
+	    (!mHistogram.empty() && (other.mLower != mLower || other.mUpper != mUpper))) {
+		throw std::invalid_argument("TraceStatistics: histograms differ");
+	}
+
+	mergeMoments(other.mCount, other.mMean, other.mM2, other.mMin, other.mMax);
+	for (size_t ii = 0; ii < mHistogram.size(); ++ii) {
+		mHistogram[ii] += other.mHistogram[ii];
+	}
+	mUnderflow += other.mUnderflow;
+	mOverflow += other.mOverflow;
+}
+
+void TraceStatistics::mergeMoments(
+	size_t const count, double const mean, double const m2,
+	double const min, double const max)
+{
+	if (count == 0) {
+		return;
+	}
+
+	// Chan et al., parallel algorithm for the variance
+	size_t const total = mCount + count;
+	double const delta = mean - mMean;
+	mMean += delta * count / total;
+	mM2 += m2 + delta * delta * mCount / total * count;
+	mCount = total;
+	mMin = std::min(mMin, min);
+	mMax = std::max(mMax, max);
+}
+
+void TraceStatistics::bin(double const value)
+{
+	if (mHistogram.empty()) {
+		return;
+	}
+
+	if (value < mLower) {
+		++mUnderflow;
+	} else if (value >= mUpper || std::isnan(value)) {
+		++mOverflow;
+	} else {
+		size_t const bin = (value - mLower) / (mUpper - mLower) * mHistogram.size();
+		++mHistogram[std::min(bin, mHistogram.size() - 1)];
+	}
+}
+
+size_t TraceStatistics::count() const
+{
+	return mCount;
+}
+
+double TraceStatistics::mean() const
+{
+	return mCount ? mMean : std::numeric_limits<double>::quiet_NaN();
+}
+
+double TraceStatistics::variance() const
+{
+	return mCount ? mM2 / mCount : std::numeric_limits<double>::quiet_NaN();
+}
+
+double TraceStatistics::std() const
+{
+	return std::sqrt(variance());
+}
+
+double TraceStatistics::min() const
+{
+	return mMin;
+}
+
+double TraceStatistics::max() const
+{
+	return mMax;
+}
+
+std::vector<size_t> TraceStatistics::histogram() const
+{
+	return mHistogram;
+}
+
+size_t TraceStatistics::underflow() const
+{
+	return mUnderflow;
+}
+
+size_t TraceStatistics::overflow() const
+{
+	return mOverflow;
+}
+
+double TraceStatistics::binEdge(size_t const bin) const
+{
+	if (bin > mHistogram.size()) {
+		throw std::out_of_range("TraceStatistics: invalid bin");
+	}
+	return mLower + (mUpper - mLower) * bin / mHistogram.size();
+}
+
+DataPoint TraceStatistics::toDataPoint(DataPoint::value_type const ref) const
+{
+	return DataPoint(ref, mean(), std());
+}
+
+} // ADC
+} // HMF
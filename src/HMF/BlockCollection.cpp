@@ -54,4 +54,48 @@ HWSharedParameter BlockCollection::applySharedCalibration(double v_reset, size_t
 
 }
 
+void BlockCollection::applySharedCalibration(
+	double const* v_reset, size_t const* hw_shared_ids, size_t const n,
+	HWSharedParameter* out) const
+{
+	_applySharedCalibration(v_reset, hw_shared_ids, n, out, nullptr);
+}
+
+void BlockCollection::applySharedCalibration(
+	double const* v_reset, size_t const* hw_shared_ids, size_t const n,
+	HWSharedParameter* out, calibtic::Executor& executor) const
+{
+	_applySharedCalibration(v_reset, hw_shared_ids, n, out, &executor);
+}
+
+void BlockCollection::_applySharedCalibration(
+	double const* v_reset, size_t const* hw_shared_ids, size_t const n,
+	HWSharedParameter* out, calibtic::Executor* executor) const
+{
+	// all lookups are done up front, the workers only read the calibrations
+	std::vector<SharedCalibration const*> calibs(n);
+	for (size_t ii = 0; ii < n; ++ii) {
+		size_t const hw_shared_id = hw_shared_ids[ii];
+		if (!exists(hw_shared_id) || !at(hw_shared_id)) {
+			throw std::runtime_error("no calibration data for this fg block");
+		}
+		calibs[ii] = dynamic_cast<SharedCalibration const*>(at(hw_shared_id).get());
+		if (!calibs[ii]) {
+			throw std::runtime_error("calibration data of this fg block is no SharedCalibration");
+		}
+	}
+
+	auto const apply = [&](size_t const begin, size_t const end) {
+		for (size_t ii = begin; ii < end; ++ii) {
+			out[ii] = calibs[ii]->applySharedCalibration(v_reset[ii]);
+		}
+	};
+
+	if (executor) {
+		executor->parallel_for(n, apply);
+	} else {
+		apply(0, n);
+	}
+}
+
 } // HMF
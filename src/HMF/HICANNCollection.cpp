@@ -1,7 +1,18 @@
 #include "calibtic/HMF/HICANNCollection.h"
 
+#include <array>
+#include <mutex>
+
 namespace HMF {
 
+struct HICANNCollection::Sections
+{
+	section_loader loader;
+	std::array<std::once_flag, Collection_ID::Size> loaded;
+	/// entries when the loader was set, only these are filled
+	std::array<value_type, Collection_ID::Size> placeholders;
+};
+
 HICANNCollection::HICANNCollection()
 {
 
@@ -87,6 +98,7 @@ void HICANNCollection::setDefaults()
 boost::shared_ptr<NeuronCollection> HICANNCollection::atNeuronCollection()
 {
 
+	loadSection(Collection_ID::Neuron);
 	if(!exists(Collection_ID::Neuron)) {
 		throw std::runtime_error("HICANNCollection: missing neuron collection");
 	}
@@ -100,6 +112,7 @@ boost::shared_ptr<NeuronCollection> HICANNCollection::atNeuronCollection()
 boost::shared_ptr<BlockCollection> HICANNCollection::atBlockCollection()
 {
 
+	loadSection(Collection_ID::Block);
 	if(!exists(Collection_ID::Block)) {
 		throw std::runtime_error("HICANNCollection: missing block collection");
 	}
@@ -112,6 +125,7 @@ boost::shared_ptr<BlockCollection> HICANNCollection::atBlockCollection()
 boost::shared_ptr<SynapseRowCollection> HICANNCollection::atSynapseRowCollection()
 {
 
+	loadSection(Collection_ID::SynapseRow);
 	if(!exists(Collection_ID::SynapseRow)) {
 		throw std::runtime_error("HICANNCollection: missing synapse row collection");
 	}
@@ -123,6 +137,7 @@ boost::shared_ptr<SynapseRowCollection> HICANNCollection::atSynapseRowCollection
 
 boost::shared_ptr<L1CrossbarCollection> HICANNCollection::atL1CrossbarCollection()
 {
+	loadSection(Collection_ID::L1Crossbar);
 	if (!exists(Collection_ID::L1Crossbar)) {
 		throw std::runtime_error("HICANNCollection: missing L1crossbar collection");
 	}
@@ -132,6 +147,7 @@ boost::shared_ptr<L1CrossbarCollection> HICANNCollection::atL1CrossbarCollection
 
 boost::shared_ptr<SynapseChainLengthCollection> HICANNCollection::atSynapseChainLengthCollection()
 {
+	loadSection(Collection_ID::SynapseChainLength);
 	if (!exists(Collection_ID::SynapseChainLength)) {
 		throw std::runtime_error("HICANNCollection: missing SynapseChainLength collection");
 	}
@@ -142,6 +158,7 @@ boost::shared_ptr<SynapseChainLengthCollection> HICANNCollection::atSynapseChain
 
 boost::shared_ptr<SynapseSwitchCollection> HICANNCollection::atSynapseSwitchCollection()
 {
+	loadSection(Collection_ID::SynapseSwitches);
 	if (!exists(Collection_ID::SynapseSwitches)) {
 		throw std::runtime_error("HICANNCollection: missing SynapseSwitch collection");
 	}
@@ -152,6 +169,7 @@ boost::shared_ptr<SynapseSwitchCollection> HICANNCollection::atSynapseSwitchColl
 #ifndef PYPLUSPLUS
 const boost::shared_ptr<const NeuronCollection> HICANNCollection::atNeuronCollection() const {
 
+	loadSection(Collection_ID::Neuron);
 	if(!exists(Collection_ID::Neuron)) {
 		throw std::runtime_error("HICANNCollection: missing neuron collection");
 	}
@@ -164,6 +182,7 @@ const boost::shared_ptr<const NeuronCollection> HICANNCollection::atNeuronCollec
 
 const boost::shared_ptr<const BlockCollection> HICANNCollection::atBlockCollection() const {
 
+	loadSection(Collection_ID::Block);
 	if(!exists(Collection_ID::Block)) {
 		throw std::runtime_error("HICANNCollection: missing block collection");
 	}
@@ -174,6 +193,7 @@ const boost::shared_ptr<const BlockCollection> HICANNCollection::atBlockCollecti
 
 const boost::shared_ptr<const SynapseRowCollection> HICANNCollection::atSynapseRowCollection() const {
 
+	loadSection(Collection_ID::SynapseRow);
 	if(!exists(Collection_ID::SynapseRow)) {
 		throw std::runtime_error("HICANNCollection: missing synapse row collection");
 	}
@@ -185,6 +205,7 @@ const boost::shared_ptr<const SynapseRowCollection> HICANNCollection::atSynapseR
 
 const boost::shared_ptr<const L1CrossbarCollection> HICANNCollection::atL1CrossbarCollection() const
 {
+	loadSection(Collection_ID::L1Crossbar);
 	if (!exists(Collection_ID::L1Crossbar)) {
 		throw std::runtime_error("HICANNCollection: missing L1Crossbar collection");
 	}
@@ -197,6 +218,7 @@ const boost::shared_ptr<const L1CrossbarCollection> HICANNCollection::atL1Crossb
 const boost::shared_ptr<const SynapseChainLengthCollection>
 HICANNCollection::atSynapseChainLengthCollection() const
 {
+	loadSection(Collection_ID::SynapseChainLength);
 	if (!exists(Collection_ID::SynapseChainLength)) {
 		throw std::runtime_error("HICANNCollection: missing synapseChainLength collection");
 	}
@@ -210,6 +232,7 @@ HICANNCollection::atSynapseChainLengthCollection() const
 const boost::shared_ptr<const SynapseSwitchCollection> HICANNCollection::atSynapseSwitchCollection()
     const
 {
+	loadSection(Collection_ID::SynapseSwitches);
 	if (!exists(Collection_ID::SynapseSwitches)) {
 		throw std::runtime_error("HICANNCollection: missing synapseSwitch collection");
 	}
@@ -284,8 +307,102 @@ void HICANNCollection::copy(Collection const& rhs)
 	*this = dynamic_cast<HICANNCollection const&>(rhs);
 }
 
+void HICANNCollection::setSectionLoader(section_loader const& loader)
+{
+	mSections.reset(new Sections);
+	mSections->loader = loader;
+	for (key_type key = 0; key < Collection_ID::Size; ++key) {
+		auto const it = mBases.find(key);
+		if (it != mBases.end()) {
+			mSections->placeholders[key] = it->second;
+		}
+	}
+}
+
+HICANNCollection::value_type HICANNCollection::at(key_type const& key)
+{
+	loadSection(key);
+	return Collection::at(key);
+}
+
+HICANNCollection::const_value_type HICANNCollection::at(key_type const& key) const
+{
+	loadSection(key);
+	return Collection::at(key);
+}
+
+void HICANNCollection::intern(calibtic::trafo::Pool& pool)
+{
+	loadSections();
+	Collection::intern(pool);
+}
+
+void HICANNCollection::loadSections() const
+{
+	for (key_type key = 0; key < Collection_ID::Size; ++key) {
+		loadSection(key);
+	}
+}
+
+void HICANNCollection::loadSection(key_type const key) const
+{
+	if (!mSections || key < 0 || key >= Collection_ID::Size) {
+		return;
+	}
+
+	// concurrent accesses wait for the first one, loading is retried if the
+	// loader throws
+	std::call_once(mSections->loaded[key], [this, key] {
+		// erased or replaced by the user, their entry is kept
+		auto const it = mBases.find(key);
+		if (it == mBases.end() || !it->second ||
+			it->second != mSections->placeholders[key]) {
+			return;
+		}
+
+		// filled in place, the entry may already be referenced by copies
+		Collection& section = dynamic_cast<Collection&>(*it->second);
+		value_type const stored = mSections->loader(key);
+		if (stored) {
+			section.copy(dynamic_cast<Collection const&>(*stored));
+			return;
+		}
+
+		switch (key) {
+			case Collection_ID::Neuron:
+				dynamic_cast<NeuronCollection&>(section).setDefaults();
+				break;
+			case Collection_ID::Block:
+				dynamic_cast<BlockCollection&>(section).setDefaults();
+				break;
+			case Collection_ID::SynapseRow:
+				dynamic_cast<SynapseRowCollection&>(section).setDefaults();
+				break;
+			case Collection_ID::L1Crossbar:
+				dynamic_cast<L1CrossbarCollection&>(section).setDefaults();
+				break;
+			case Collection_ID::SynapseChainLength:
+				dynamic_cast<SynapseChainLengthCollection&>(section).setDefaults();
+				break;
+			case Collection_ID::SynapseSwitches:
+				dynamic_cast<SynapseSwitchCollection&>(section).setDefaults();
+				break;
+		}
+	});
+}
+
+bool HICANNCollection::operator== (Base const& rhs) const
+{
+	loadSections();
+	if (HICANNCollection const* _rhs = dynamic_cast<HICANNCollection const*>(&rhs)) {
+		_rhs->loadSections();
+	}
+	return Collection::operator==(rhs);
+}
+
 std::ostream& HICANNCollection::operator<< (std::ostream& os) const
 {
+	loadSections();
 	os << "HICANNCollection:"
 		<< " speedup: " << mSpeedup
 		<< " pll: " << mPLLFrequency;
@@ -412,18 +412,27 @@ void NeuronCalibration::populateWithDefault(NeuronCalibration* cal) const
 
 NeuronCalibration::NeuronCalibration(bool has_default) :
 	Calibration(NeuronCalibrationParameters::Calibrations::NCAL_SIZE),
-	mDefault(nullptr)
+	mDefault()
 {
 	if(has_default) {
-		// default calibration does not hold default again
-		mDefault = new NeuronCalibration(false);
-		populateWithDefault(mDefault);
+		mDefault = sharedDefault();
 	}
 }
 
 NeuronCalibration::~NeuronCalibration()
 {
-	delete mDefault;
+}
+
+boost::shared_ptr<NeuronCalibration const> NeuronCalibration::sharedDefault()
+{
+	// thread-safe initialization on first use
+	static boost::shared_ptr<NeuronCalibration const> const instance = [] {
+		// default calibration does not hold default again
+		boost::shared_ptr<NeuronCalibration> cal(new NeuronCalibration(false));
+		cal->populateWithDefault(cal.get());
+		return boost::shared_ptr<NeuronCalibration const>(cal);
+	}();
+	return instance;
 }
 
 void NeuronCalibration::setDefaults()
@@ -480,6 +489,24 @@ HWNeuronParameter NeuronCalibration::applyNeuronCalibration(
 	return _applyNeuronCalibration(p, speedup, params);
 }
 
+void NeuronCalibration::applyNeuronCalibration(
+	EIF_cond_exp_isfa_ista const* p,
+	size_t const* index, size_t const n,
+	double const speedup, HWNeuronParameter* out,
+	NeuronCalibrationParameters const& params) const
+{
+	_applyNeuronCalibration(p, index, n, speedup, out, params);
+}
+
+void NeuronCalibration::applyNeuronCalibration(
+	IF_cond_exp const* p,
+	size_t const* index, size_t const n,
+	double const speedup, HWNeuronParameter* out,
+	NeuronCalibrationParameters const& params) const
+{
+	_applyNeuronCalibration(p, index, n, speedup, out, params);
+}
+
 PyNNParameters::EIF_cond_exp_isfa_ista NeuronCalibration::scaleParameters(
 	PyNNParameters::EIF_cond_exp_isfa_ista const& p,
 	double const shiftV, double const alphaV,
@@ -1025,6 +1052,174 @@ HWNeuronParameter NeuronCalibration::_applyNeuronCalibration<PyNNParameters::IF_
 	double const speedup,
 	NeuronCalibrationParameters const& params) const;
 
+void NeuronCalibration::applyColumn(
+	std::vector<double> const& v,
+	Calibrations::calib const c, int const hw,
+	char const* name, hw_value const fallback,
+	size_t const* index, HWNeuronParameter* out) const
+{
+	size_t const n = v.size();
+	std::vector<double> val(n);
+
+	try {
+		applyMany(v.data(), val.data(), n, c);
+	} catch (const std::exception&) {
+		// same handling as to_dac, neuron by neuron
+		for (size_t ii = 0; ii < n; ++ii) {
+			hw_value& h = out[index[ii]].parameters()[hw];
+			try {
+				h = to_dac(v[ii], c);
+			} catch (const std::exception& e) {
+				LOG4CXX_WARN(_log, "Calibtic::NeuronCalibration: cannot calibrate " << name << ", because: " << e.what());
+				if (fallback >= 0) {
+					h = fallback;
+				}
+			}
+		}
+		return;
+	}
+
+	size_t clipped = 0;
+	for (size_t ii = 0; ii < n; ++ii) {
+		const int dac = round(val[ii]);
+		const int dac_clipped = clip_fg_value(dac);
+		clipped += (dac != dac_clipped);
+		out[index[ii]].parameters()[hw] = dac_clipped;
+	}
+
+	if (clipped) {
+		LOG4CXX_WARN(
+		    _log, clipped << " of " << n << " digital FG values of neuron parameter "
+		                  << to_string(c) << " clipped");
+	}
+}
+
+template<typename CellType>
+void NeuronCalibration::_applyNeuronCalibration(
+	CellType const* p,
+	size_t const* index, size_t const n,
+	double const speedup, HWNeuronParameter* out,
+	NeuronCalibrationParameters const& params) const
+{
+	LOG4CXX_DEBUG(_log, "NeuronCalibration::applyNeuronCalibration for " << n << " neurons");
+
+	check();
+
+	if (HWNeuronParameter::size() != HICANN::neuron_parameter::__last_neuron) {
+		throw std::range_error(std::string(__PRETTY_FUNCTION__) + ": NeuronCalibration parameters has incorrect length");
+	}
+
+	for (size_t ii = 0; ii < n; ++ii) {
+		out[index[ii]] = HWNeuronParameter();
+	}
+
+	if (n == 0) {
+		return;
+	}
+
+	// parameters without case distinctions are calibrated column by column,
+	// the order of the single neuron version is kept
+	std::vector<double> v(n);
+
+	// LIF dynamics
+	for (size_t ii = 0; ii < n; ++ii) {
+		v[ii] = scaleTau(p[index[ii]].tau_m, speedup);
+	}
+	applyColumn(v, params.I_gl(), HICANN::neuron_parameter::I_gl, "I_gl", 409, index, out);
+
+	for (size_t ii = 0; ii < n; ++ii) {
+		v[ii] = scaleVoltage(p[index[ii]].v_rest, params.shiftV, params.alphaV);
+	}
+	applyColumn(v, Calibrations::E_l, HICANN::neuron_parameter::E_l, "E_l", -1, index, out);
+
+	size_t saturated = 0;
+	for (size_t ii = 0; ii < n; ++ii) {
+		v[ii] = scaleVoltage(p[index[ii]].e_rev_E, params.shiftV, params.alphaV);
+		saturated += (v[ii] > 1.4);
+	}
+	if (saturated) {
+		LOG4CXX_WARN(
+		    _log, "Calibtic::NeuronCalibration: Esynx of "
+		              << saturated << " of " << n
+		              << " neurons is set to a hardware value above 1.4V, where calibration "
+		                 "shows a saturation of the reversal potential. Consider using a "
+		                 "different parameter transformation.");
+	}
+	applyColumn(v, Calibrations::E_synx, HICANN::neuron_parameter::E_synx, "E_synx", -1, index, out);
+
+	for (size_t ii = 0; ii < n; ++ii) {
+		v[ii] = scaleVoltage(p[index[ii]].e_rev_I, params.shiftV, params.alphaV);
+	}
+	applyColumn(v, Calibrations::E_syni, HICANN::neuron_parameter::E_syni, "E_syni", -1, index, out);
+
+	// refractory period
+	for (size_t ii = 0; ii < n; ++ii) {
+		v[ii] = scaleTau(p[index[ii]].tau_refrac, speedup);
+	}
+	applyColumn(v, Calibrations::I_pl, HICANN::neuron_parameter::I_pl, "I_pl", -1, index, out);
+
+	// spiking threshold, adaptation and exponential term depend on the
+	// parameters of each neuron
+	for (size_t ii = 0; ii < n; ++ii) {
+		CellType const& cell = p[index[ii]];
+		std::vector<hw_value>& h = out[index[ii]].parameters();
+		setSpikingThreshold(cell, h, params.shiftV, params.alphaV);
+		setAdaptionParameters(cell, h, speedup, params);
+		setExponentialTerm(cell, h, params.shiftV, params.alphaV);
+	}
+
+	// synaptic input
+	for (size_t ii = 0; ii < n; ++ii) {
+		v[ii] = scaleTau(p[index[ii]].tau_syn_E, speedup);
+	}
+	applyColumn(v, Calibrations::V_syntcx, HICANN::neuron_parameter::V_syntcx, "V_syntcx", 820, index, out);
+
+	for (size_t ii = 0; ii < n; ++ii) {
+		v[ii] = scaleTau(p[index[ii]].tau_syn_I, speedup);
+	}
+	applyColumn(v, Calibrations::V_syntci, HICANN::neuron_parameter::V_syntci, "V_syntci", 820, index, out);
+
+	// biases (TECHNICAL PARAMETERS) do not depend on the neuron parameters,
+	// they are calibrated once for all neurons
+	static const std::pair<Calibrations::calib, HICANN::neuron_parameter> biases[] = {
+		{Calibrations::V_convoffi, HICANN::neuron_parameter::V_convoffi},
+		{Calibrations::V_convoffx, HICANN::neuron_parameter::V_convoffx},
+		{Calibrations::I_convi, HICANN::neuron_parameter::I_convi},
+		{Calibrations::I_convx, HICANN::neuron_parameter::I_convx},
+		{Calibrations::I_intbbi, HICANN::neuron_parameter::I_intbbi},
+		{Calibrations::I_intbbx, HICANN::neuron_parameter::I_intbbx},
+		{Calibrations::V_syni, HICANN::neuron_parameter::V_syni},
+		{Calibrations::V_synx, HICANN::neuron_parameter::V_synx},
+		{Calibrations::I_spikeamp, HICANN::neuron_parameter::I_spikeamp}};
+
+	for (auto const& bias : biases) {
+		try {
+			hw_value const dac = to_dac(-1 /*anyValue*/, bias.first);
+			for (size_t ii = 0; ii < n; ++ii) {
+				out[index[ii]].parameters()[bias.second] = dac;
+			}
+		} catch (const std::exception& e) {
+			LOG4CXX_WARN(_log, "Calibtic::NeuronCalibration: cannot calibrate " << to_string(bias.first) << ", because: " << e.what());
+		}
+	}
+
+	LOG4CXX_DEBUG(_log, "NeuronCalibration::applyNeuronCalibration succesfully applied to " << n << " neurons");
+}
+
+template
+void NeuronCalibration::_applyNeuronCalibration<PyNNParameters::EIF_cond_exp_isfa_ista>(
+	PyNNParameters::EIF_cond_exp_isfa_ista const* p,
+	size_t const* index, size_t const n,
+	double const speedup, HWNeuronParameter* out,
+	NeuronCalibrationParameters const& params) const;
+
+template
+void NeuronCalibration::_applyNeuronCalibration<PyNNParameters::IF_cond_exp>(
+	PyNNParameters::IF_cond_exp const* p,
+	size_t const* index, size_t const n,
+	double const speedup, HWNeuronParameter* out,
+	NeuronCalibrationParameters const& params) const;
+
 PyNNParameters::EIF_cond_exp_isfa_ista
 NeuronCalibration::applyNeuronReverse(
 	HWNeuronParameter const& param,
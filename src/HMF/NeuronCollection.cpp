@@ -46,6 +46,44 @@ HWNeuronParameter NeuronCollection::applyNeuronCalibration(
 	return _applyNeuronCalibration(model_params, hw_neuron_id, params);
 }
 
+void NeuronCollection::applyNeuronCalibration(
+	PyNNParameters::EIF_cond_exp_isfa_ista const* model_params,
+	size_t const* hw_neuron_ids, size_t const n,
+	HWNeuronParameter* out,
+	NeuronCalibrationParameters const& params) const
+{
+	_applyNeuronCalibration(model_params, hw_neuron_ids, n, out, nullptr, params);
+}
+
+void NeuronCollection::applyNeuronCalibration(
+	PyNNParameters::IF_cond_exp const* model_params,
+	size_t const* hw_neuron_ids, size_t const n,
+	HWNeuronParameter* out,
+	NeuronCalibrationParameters const& params) const
+{
+	_applyNeuronCalibration(model_params, hw_neuron_ids, n, out, nullptr, params);
+}
+
+void NeuronCollection::applyNeuronCalibration(
+	PyNNParameters::EIF_cond_exp_isfa_ista const* model_params,
+	size_t const* hw_neuron_ids, size_t const n,
+	HWNeuronParameter* out,
+	calibtic::Executor& executor,
+	NeuronCalibrationParameters const& params) const
+{
+	_applyNeuronCalibration(model_params, hw_neuron_ids, n, out, &executor, params);
+}
+
+void NeuronCollection::applyNeuronCalibration(
+	PyNNParameters::IF_cond_exp const* model_params,
+	size_t const* hw_neuron_ids, size_t const n,
+	HWNeuronParameter* out,
+	calibtic::Executor& executor,
+	NeuronCalibrationParameters const& params) const
+{
+	_applyNeuronCalibration(model_params, hw_neuron_ids, n, out, &executor, params);
+}
+
 size_t NeuronCollection::getSpeedup() const
 {
 	return mSpeedup;
@@ -3,6 +3,9 @@
 #include "calibtic/trafo/Polynomial.h"
 #include "calibtic/trafo/Constant.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <type_traits>
 
 #include <log4cxx/logger.h>
@@ -34,19 +37,65 @@ HICANN::SynapseWeight SynapseCalibration::getDigitalWeight(
 	double const analog_weight
 	) const
 {
-	// TODO: several optimizations are possible:
-	// 1.) pre-calculate all 16 analog weights
-	// 2.) using ReverseTrafo to find digital weight
+	return _getDigitalWeight(
+		*weightTable(), analog_weight, [] { return (double)rand() / RAND_MAX; });
+}
+
+HICANN::SynapseWeight SynapseCalibration::getDigitalWeight(
+	double const analog_weight,
+	uint64_t const seed,
+	uint64_t const synapse) const
+{
+	calibtic::Philox4x32 rng(seed, synapse);
+	return getDigitalWeight(analog_weight, rng);
+}
+
+HICANN::SynapseWeight SynapseCalibration::getDigitalWeight(
+	double const analog_weight,
+	calibtic::Philox4x32& rng) const
+{
+	return _getDigitalWeight(
+		*weightTable(), analog_weight, [&rng] { return calibtic::canonical(rng); });
+}
+
+void SynapseCalibration::getDigitalWeights(
+	double const* analog_weight, size_t const n,
+	HICANN::SynapseWeight* out,
+	uint64_t const seed,
+	uint64_t const first_synapse) const
+{
+	std::shared_ptr<WeightTable const> const table = weightTable();
+	for (size_t ii = 0; ii < n; ++ii) {
+		calibtic::Philox4x32 rng(seed, first_synapse + ii);
+		out[ii] = _getDigitalWeight(
+			*table, analog_weight[ii], [&rng] { return calibtic::canonical(rng); });
+	}
+}
+
+template<typename Uniform>
+HICANN::SynapseWeight SynapseCalibration::_getDigitalWeight(
+	WeightTable const& table, double const analog_weight, Uniform const& uniform) const
+{
+	std::array<analog_weight_t, num_weights> const& aw = table.analog;
+
 	int id_of_first_smaller = -1;
-	// this assumes a monoton increasing of synaptic weights
-	for (size_t dw = HICANN::SynapseWeight::min; dw <= HICANN::SynapseWeight::max; ++dw)
-	{
-		double aw = getAnalogWeight(HICANN::SynapseWeight(dw));
-		if ( aw < analog_weight)
-			id_of_first_smaller = dw;
-		else
-			break;
+	if (table.monotonic) {
+		// branchless, the number of smaller weights is the index + 1
+		size_t smaller = 0;
+		for (size_t dw = 0; dw < num_weights; ++dw) {
+			smaller += (aw[dw] < analog_weight);
+		}
+		id_of_first_smaller += smaller;
+	} else {
+		// same as above for monotonic increasing weights
+		for (size_t dw = 0; dw < num_weights; ++dw) {
+			if (aw[dw] < analog_weight)
+				id_of_first_smaller = dw;
+			else
+				break;
+		}
 	}
+
 	if (id_of_first_smaller == -1) {
 		return HICANN::SynapseWeight(HICANN::SynapseWeight::min);
 	}
@@ -54,11 +103,31 @@ HICANN::SynapseWeight SynapseCalibration::getDigitalWeight(
 		return HICANN::SynapseWeight(HICANN::SynapseWeight::max);
 	}
 	else {
-		double aw_l = getAnalogWeight(HICANN::SynapseWeight(id_of_first_smaller));
-		double aw_h = getAnalogWeight(HICANN::SynapseWeight(id_of_first_smaller + 1));
+		double aw_l = aw[id_of_first_smaller];
+		double aw_h = aw[id_of_first_smaller + 1];
 		double remainder =  (analog_weight - aw_l)/(aw_h-aw_l);
-		return HICANN::SynapseWeight(id_of_first_smaller + ((double)rand() / RAND_MAX < remainder));
+		return HICANN::SynapseWeight(id_of_first_smaller + (uniform() < remainder));
+	}
+}
+
+std::shared_ptr<SynapseCalibration::WeightTable const>
+SynapseCalibration::weightTable() const
+{
+	std::shared_ptr<WeightTable const> table = std::atomic_load(&mWeightTable);
+	if (!table || table->trafo != mTrafo[0]) {
+		auto fresh = std::make_shared<WeightTable>();
+		fresh->trafo = mTrafo[0];
+		for (size_t dw = HICANN::SynapseWeight::min; dw <= HICANN::SynapseWeight::max; ++dw) {
+			fresh->analog[dw] = getAnalogWeight(HICANN::SynapseWeight(dw));
+		}
+		fresh->monotonic =
+			std::is_sorted(fresh->analog.begin(), fresh->analog.end()) &&
+			std::none_of(fresh->analog.begin(), fresh->analog.end(),
+			             [](analog_weight_t aw) { return std::isnan(aw); });
+		table = fresh;
+		std::atomic_store(&mWeightTable, table);
 	}
+	return table;
 }
 
 SynapseCalibration::analog_weight_t
@@ -2,7 +2,10 @@
 #include "calibtic/trafo/Transformation.h"
 #include "calibtic/trafo/Polynomial.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
 
 #include <log4cxx/logger.h>
 
@@ -10,10 +13,15 @@ static log4cxx::LoggerPtr _log = log4cxx::Logger::getLogger("Calibtic");
 
 namespace HMF {
 
+SynapseRowCalibration::SynapseRowCalibration() :
+	mMaxWeightsValid(false)
+{}
+
 SynapseRowCalibration::~SynapseRowCalibration() {}
 
 void SynapseRowCalibration::setDefaults()
 {
+	mMaxWeightsValid = false;
 	boost::shared_ptr<SynapseCalibration> sc(new SynapseCalibration);
 	sc->setDefaults();
 	mTrafo[GmaxConfig::Default()] = sc;
@@ -57,6 +65,7 @@ void SynapseRowCalibration::setEssDefaults()
 		boost::shared_ptr<SynapseCalibration> sc(new SynapseCalibration);
 		sc->reset(0, calibtic::trafo::Polynomial::create(new_coeffs, HICANN::SynapseWeight::min, HICANN::SynapseWeight::max));
 		mTrafo[ gc ] = sc;
+		mMaxWeightsValid = false;
 		sel_gmax++;
 	}
 }
@@ -76,7 +85,10 @@ SynapseRowCalibration::value_type
 SynapseRowCalibration::at(SynapseRowCalibration::key_type const key)
 {
 	SynapseRowCalibration const& t = *this;
-	return boost::const_pointer_cast<trafo_t>(t.at(key));
+	value_type val = boost::const_pointer_cast<trafo_t>(t.at(key));
+	// the caller may modify the calibration
+	mMaxWeightsValid = false;
+	return val;
 }
 
 SynapseRowCalibration::size_type
@@ -85,6 +97,17 @@ SynapseRowCalibration::size() const
 	return mTrafo.size();
 }
 
+std::vector<SynapseRowCalibration::key_type>
+SynapseRowCalibration::keys() const
+{
+	std::vector<key_type> res;
+	res.reserve(mTrafo.size());
+	for (auto const& pair : mTrafo) {
+		res.push_back(pair.first);
+	}
+	return res;
+}
+
 void SynapseRowCalibration::insert(key_type const& key, value_type value)
 {
 	auto ins = mTrafo.insert(std::make_pair(key, value));
@@ -92,17 +115,20 @@ void SynapseRowCalibration::insert(key_type const& key, value_type value)
 	if (!ins.second) {
 		throw std::runtime_error("SynapseRowCalibration::insert(..): key already exists");
 	}
+	mMaxWeightsValid = false;
 }
 
 SynapseRowCalibration::size_type
 SynapseRowCalibration::erase(key_type const& key)
 {
+	mMaxWeightsValid = false;
 	return mTrafo.erase(key);
 }
 
 void SynapseRowCalibration::clear()
 {
 	mTrafo.clear();
+	mMaxWeightsValid = false;
 }
 
 bool SynapseRowCalibration::exists(key_type const& key) const
@@ -145,12 +171,36 @@ void SynapseRowCalibration::copy(SynapseRowCalibration const& rhs)
 	*this = rhs;
 }
 
+void SynapseRowCalibration::intern(calibtic::trafo::Pool& pool)
+{
+	for (auto& pair : mTrafo) {
+		if (pair.second) {
+			pair.second->intern(pool);
+		}
+	}
+	mMaxWeightsValid = false;
+}
+
 std::ostream& operator<< (std::ostream& os, SynapseRowCalibration const& t)
 {
 	return t.operator<<(os);
 }
 
 
+void SynapseRowCalibration::updateMaxWeights()
+{
+	mMaxWeights.clear();
+	for (auto const& trafo : mTrafo) {
+		double const max_weight = trafo.second->getMaxAnalogWeight();
+		// NaN never compares favorably, such configs are never chosen
+		if (!std::isnan(max_weight)) {
+			mMaxWeights.push_back(std::make_pair(max_weight, trafo.first));
+		}
+	}
+	std::sort(mMaxWeights.begin(), mMaxWeights.end());
+	mMaxWeightsValid = true;
+}
+
 GmaxConfig
 SynapseRowCalibration::findBestGmaxConfig(double max_required_weight)
 {
@@ -167,33 +217,41 @@ SynapseRowCalibration::findBestGmaxConfig(double max_required_weight)
 		// 1) max_required_weight <= max_analog_weight
 		// 2) absolute difference (max_analog_weight - max_required_weight) is minimal
 		// if 1) cannot be fulfilled, only 2) applies.
-
-		// Searching for 1) first.
-		std::map<key_type, value_type> candidates_fullfilling_1;
-		for (auto const & trafo : mTrafo ) {
-			if (max_required_weight <= trafo.second->getMaxAnalogWeight())
-				candidates_fullfilling_1.insert(trafo);
+		// Ties are resolved in favor of the smallest config.
+		if (!mMaxWeightsValid) {
+			updateMaxWeights();
 		}
 
-		// If no candidate fulfills 1), use all for 2)
-		std::map<key_type, value_type>* canditates_for_2;
-		if (candidates_fullfilling_1.size() > 0)
-			canditates_for_2 = & candidates_fullfilling_1;
-		else
-			canditates_for_2  = & mTrafo;
+		typedef std::pair<double, key_type> entry_type;
+		auto const first_fullfilling_1 = std::lower_bound(
+			mMaxWeights.begin(), mMaxWeights.end(), max_required_weight,
+			[](entry_type const& entry, double weight) { return entry.first < weight; });
 
-		// Search for 2)
+		// Search for 2), the absolute difference grows with the distance in
+		// the sorted array, only entries with the same difference are compared
 		double lowest_abs_diff = std::numeric_limits<double>::infinity();
-		for (auto const & trafo : *canditates_for_2 ) {
-			double abs_diff = std::abs(max_required_weight - trafo.second->getMaxAnalogWeight());
-			if ( abs_diff < lowest_abs_diff ){
-				lowest_abs_diff  = abs_diff;
-				rv = trafo.first;
+		auto consider = [&](entry_type const& entry) {
+			double const abs_diff = std::abs(max_required_weight - entry.first);
+			if (abs_diff < lowest_abs_diff || (abs_diff == lowest_abs_diff &&
+			                                   abs_diff < std::numeric_limits<double>::infinity() &&
+			                                   entry.second < rv)) {
+				lowest_abs_diff = abs_diff;
+				rv = entry.second;
+				return true;
 			}
-		}
+			return abs_diff == lowest_abs_diff;
+		};
 
+		if (first_fullfilling_1 != mMaxWeights.end()) {
+			for (auto it = first_fullfilling_1; it != mMaxWeights.end() && consider(*it); ++it) {
+			}
+		} else {
+			// If no candidate fulfills 1), the largest weights are closest
+			for (auto it = mMaxWeights.rbegin(); it != mMaxWeights.rend() && consider(*it); ++it) {
+			}
+		}
 	}
-	LOG4CXX_DEBUG(_log, "SynapseRowCalibration::findBestGmaxConfig(max_required_weight=" << max_required_weight << "): found GmaxConfig " << rv << "with min and max weight " << mTrafo[rv]->getMinAnalogWeight() << " and " << mTrafo[rv]->getMaxAnalogWeight() );
+	LOG4CXX_DEBUG(_log, "SynapseRowCalibration::findBestGmaxConfig(max_required_weight=" << max_required_weight << "): found GmaxConfig " << rv);
 	return rv;
 }
 
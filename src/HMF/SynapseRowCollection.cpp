@@ -49,4 +49,23 @@ void SynapseRowCollection::copy(calibtic::Collection const& rhs)
 	*this = dynamic_cast<SynapseRowCollection const&>(rhs);
 }
 
+void SynapseRowCollection::findBestGmaxConfig(
+	double const* max_required_weight, size_t const* rows, size_t const n,
+	GmaxConfig* out)
+{
+	for (size_t ii = 0; ii < n; ++ii) {
+		size_t const row = rows[ii];
+		if (!exists(row) || !at(row)) {
+			throw std::runtime_error("no calibration data for this synapse row");
+		}
+		// rows usually share one calibration, whose sorted weights are reused
+		SynapseRowCalibration* calib =
+			dynamic_cast<SynapseRowCalibration*>(at(row).get());
+		if (!calib) {
+			throw std::runtime_error("calibration data of this synapse row is no SynapseRowCalibration");
+		}
+		out[ii] = calib->findBestGmaxConfig(max_required_weight[ii]);
+	}
+}
+
 } // HMF
@@ -0,0 +1,106 @@
+#include "calibtic/HMF/WaferCalibrationLoader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+#include <log4cxx/logger.h>
+
+#include "calibtic/MetaData.h"
+
+static log4cxx::LoggerPtr _log = log4cxx::Logger::getLogger("Calibtic");
+
+namespace HMF {
+
+WaferCalibrationLoader::WaferCalibrationLoader(
+	boost::shared_ptr<calibtic::backend::Backend> backend,
+	boost::shared_ptr<calibtic::Executor> executor,
+	size_t const max_concurrent) :
+	mBackend(backend),
+	mExecutor(executor),
+	mMaxConcurrent(max_concurrent)
+{
+	if (!mBackend) {
+		throw std::runtime_error("WaferCalibrationLoader: no backend");
+	}
+	if (!mExecutor) {
+		mExecutor = calibtic::Executor::create(mMaxConcurrent);
+	}
+	if (mMaxConcurrent == 0 || mMaxConcurrent > mExecutor->size()) {
+		mMaxConcurrent = mExecutor->size();
+	}
+}
+
+WaferCalibrationLoader::collections_type
+WaferCalibrationLoader::load(size_t const wafer, std::vector<size_t> const& hicanns)
+{
+	std::set<size_t> const unique(hicanns.begin(), hicanns.end());
+	std::vector<size_t> const ids(unique.begin(), unique.end());
+
+	std::vector<boost::shared_ptr<HICANNCollection> > loaded(ids.size());
+	std::vector<std::string> messages(ids.size());
+
+	// each lane loads one data set after the other, taking the next one as
+	// soon as it is done, so slow files do not hold back the others
+	std::atomic<size_t> next(0);
+	size_t const lanes = std::min(mMaxConcurrent, ids.size());
+	mExecutor->parallel_for(lanes, [&](size_t const begin, size_t const end) {
+		for (size_t lane = begin; lane < end; ++lane) {
+			for (size_t ii = next++; ii < ids.size(); ii = next++) {
+				try {
+					auto const hc = HICANNCollection::create();
+					calibtic::MetaData md;
+					mBackend->load(name(wafer, ids[ii]), md, *hc);
+					loaded[ii] = hc;
+				} catch (std::exception const& err) {
+					messages[ii] = err.what();
+				} catch (...) {
+					messages[ii] = "unknown error";
+				}
+			}
+		}
+	}, 1);
+
+	collections_type res;
+	mErrors.clear();
+	for (size_t ii = 0; ii < ids.size(); ++ii) {
+		if (loaded[ii]) {
+			res[ids[ii]] = loaded[ii];
+		} else {
+			LOG4CXX_WARN(_log, "WaferCalibrationLoader: cannot load "
+				<< name(wafer, ids[ii]) << ": " << messages[ii]);
+			mErrors[ids[ii]] = messages[ii];
+		}
+	}
+	return res;
+}
+
+WaferCalibrationLoader::errors_type const& WaferCalibrationLoader::errors() const
+{
+	return mErrors;
+}
+
+void WaferCalibrationLoader::throwOnErrors() const
+{
+	if (mErrors.empty()) {
+		return;
+	}
+
+	std::stringstream err;
+	err << "WaferCalibrationLoader: " << mErrors.size() << " data sets not loaded";
+	for (auto const& error : mErrors) {
+		err << "\n\tHICANN " << error.first << ": " << error.second;
+	}
+	throw std::runtime_error(err.str());
+}
+
+std::string WaferCalibrationLoader::name(size_t const wafer, size_t const hicann)
+{
+	std::stringstream name;
+	name << "w" << wafer << "-h" << hicann;
+	return name.str();
+}
+
+} // HMF
@@ -16,9 +16,13 @@ log4cxx::LoggerPtr logger = log4cxx::Logger::getLogger("Calibtic");
 
 
 BinaryBackend::BinaryBackend() :
-	mPath(".") {}
+	mPath("."), mCompression(Compression::none) {}
 
-BinaryBackend::~BinaryBackend() {}
+BinaryBackend::~BinaryBackend()
+{
+	// pending asynchronous operations use this object
+	wait();
+}
 
 BinaryBackend::path& BinaryBackend::getPath()
 {
@@ -41,6 +45,9 @@ void BinaryBackend::init()
 			throw std::runtime_error(err.str());
 		}
 	}
+	if (exists("compression")) {
+		mCompression = compression(get<std::string>("compression"));
+	}
 }
 
 void BinaryBackend::load(
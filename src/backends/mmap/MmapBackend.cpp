@@ -0,0 +1,1210 @@
+#include "calibtic/backends/mmap/MmapBackend.h"
+#include "calibtic/backends/mmap/Format.h"
+
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+
+// polymorphic classes need to be registered in each backend
+#include "calibtic/backends/export.ipp"
+
+#include "calibtic/backend/interface.h"
+
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/stream.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/serialization/access.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <typeinfo>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace calibtic {
+namespace backend {
+
+log4cxx::LoggerPtr logger = log4cxx::Logger::getLogger("Calibtic");
+
+namespace {
+
+using namespace mmap;
+
+uint64_t align(uint64_t const bytes)
+{
+	return (bytes + 7) & ~uint64_t(7);
+}
+
+void corrupt(std::string const& what)
+{
+	throw std::runtime_error("MmapBackend: corrupt file, " + what);
+}
+
+/// read-only mapping of a whole file
+class Mapping
+{
+public:
+	explicit Mapping(std::string const& file) :
+		mData(MAP_FAILED), mSize(0)
+	{
+		int const fd = ::open(file.c_str(), O_RDONLY);
+		if (fd < 0) {
+			throw std::runtime_error("MmapBackend: cannot open " + file);
+		}
+
+		struct stat st;
+		if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+			mSize = static_cast<size_t>(st.st_size);
+			mData = ::mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+		}
+		::close(fd);
+
+		if (mData == MAP_FAILED) {
+			throw std::runtime_error("MmapBackend: cannot map " + file);
+		}
+	}
+
+	~Mapping()
+	{
+		::munmap(mData, mSize);
+	}
+
+	char const* data() const
+	{
+		return static_cast<char const*>(mData);
+	}
+
+	size_t size() const
+	{
+		return mSize;
+	}
+
+private:
+	Mapping(Mapping const&);
+	Mapping& operator=(Mapping const&);
+
+	void* mData;
+	size_t mSize;
+};
+
+
+// MetaData has no setters for its time stamps, its members are visited
+// through serialize like the Boost archives do.
+
+class MetaDataSaver
+{
+public:
+	typedef boost::mpl::bool_<false> is_loading;
+	typedef boost::mpl::bool_<true> is_saving;
+
+	MetaDataSaver(MetaRecord& record, std::string& strings) :
+		mRecord(record), mStrings(strings) {}
+
+	template<typename T>
+	MetaDataSaver& operator& (boost::serialization::nvp<T> const& nvp)
+	{
+		save(nvp.name(), nvp.const_value());
+		return *this;
+	}
+
+private:
+	void save(char const*, int const& id)
+	{
+		mRecord.id = id;
+	}
+
+	void save(char const* name, std::string const& str)
+	{
+		Range& range = std::strcmp(name, "author") == 0 ?
+			mRecord.author : mRecord.comment;
+		range.offset = mStrings.size();
+		range.size = str.size();
+		mStrings += str;
+	}
+
+	void save(char const* name, time_t const& time)
+	{
+		(std::strcmp(name, "ctime") == 0 ?
+			mRecord.creation : mRecord.modification) = time;
+	}
+
+	MetaRecord& mRecord;
+	std::string& mStrings;
+};
+
+class MetaDataLoader
+{
+public:
+	typedef boost::mpl::bool_<true> is_loading;
+	typedef boost::mpl::bool_<false> is_saving;
+
+	MetaDataLoader(MetaRecord const& record, char const* strings, size_t size) :
+		mRecord(record), mStrings(strings), mSize(size) {}
+
+	template<typename T>
+	MetaDataLoader& operator& (boost::serialization::nvp<T> const& nvp)
+	{
+		load(nvp.name(), nvp.value());
+		return *this;
+	}
+
+private:
+	void load(char const*, int& id)
+	{
+		id = static_cast<int>(mRecord.id);
+	}
+
+	void load(char const* name, std::string& str)
+	{
+		Range const& range = std::strcmp(name, "author") == 0 ?
+			mRecord.author : mRecord.comment;
+		if (range.offset > mSize || range.size > mSize - range.offset) {
+			corrupt("metadata string out of range");
+		}
+		str.assign(mStrings + range.offset, range.size);
+	}
+
+	void load(char const* name, time_t& time)
+	{
+		time = static_cast<time_t>(std::strcmp(name, "ctime") == 0 ?
+			mRecord.creation : mRecord.modification);
+	}
+
+	MetaRecord const& mRecord;
+	char const* mStrings;
+	size_t mSize;
+};
+
+
+ObjectType objectType(std::type_info const& type)
+{
+	using namespace HMF;
+	if (type == typeid(Collection))                     return COLLECTION;
+	if (type == typeid(NeuronCollection))               return NEURON_COLLECTION;
+	if (type == typeid(HICANNCollection))               return HICANN_COLLECTION;
+	if (type == typeid(BlockCollection))                return BLOCK_COLLECTION;
+	if (type == typeid(SynapseRowCollection))           return SYNAPSE_ROW_COLLECTION;
+	if (type == typeid(L1CrossbarCollection))           return L1_CROSSBAR_COLLECTION;
+	if (type == typeid(SynapseChainLengthCollection))   return SYNAPSE_CHAIN_LENGTH_COLLECTION;
+	if (type == typeid(SynapseSwitchCollection))        return SYNAPSE_SWITCH_COLLECTION;
+	if (type == typeid(Calibration))                    return CALIBRATION;
+	if (type == typeid(NeuronCalibration))              return NEURON_CALIBRATION;
+	if (type == typeid(SharedCalibration))              return SHARED_CALIBRATION;
+	if (type == typeid(SynapseCalibration))             return SYNAPSE_CALIBRATION;
+	if (type == typeid(ADC::ADCCalibration))            return ADC_CALIBRATION;
+	if (type == typeid(L1CrossbarCalibration))          return L1_CROSSBAR_CALIBRATION;
+	if (type == typeid(SynapseChainLengthCalibration))  return SYNAPSE_CHAIN_LENGTH_CALIBRATION;
+	if (type == typeid(SynapseSwitchCalibration))       return SYNAPSE_SWITCH_CALIBRATION;
+	if (type == typeid(SynapseRowCalibration))          return SYNAPSE_ROW_CALIBRATION;
+	return OBJECT_BLOB;
+}
+
+bool isCollection(uint32_t const type)
+{
+	return type >= COLLECTION && type <= SYNAPSE_SWITCH_COLLECTION;
+}
+
+bool isCalibration(uint32_t const type)
+{
+	return type >= CALIBRATION && type <= SYNAPSE_SWITCH_CALIBRATION;
+}
+
+/// number of scalars stored for objects of @param type
+size_t scalarCount(uint32_t const type)
+{
+	switch (type) {
+		case NEURON_COLLECTION:
+		case HICANN_COLLECTION:
+			return 3;
+		case L1_CROSSBAR_CALIBRATION:
+			return 2;
+		case SYNAPSE_CHAIN_LENGTH_CALIBRATION:
+		case SYNAPSE_SWITCH_CALIBRATION:
+			return 1;
+		default:
+			return 0;
+	}
+}
+
+
+/// collects the records of one file, shared objects are stored once
+class Writer
+{
+public:
+	uint32_t add(boost::shared_ptr<Base const> const& obj);
+
+	void write(std::string const& file, MetaData const& metadata, uint32_t root) const;
+
+private:
+	uint32_t add(boost::shared_ptr<trafo::Transformation const> const& t);
+
+	uint32_t push(Object record,
+				  std::vector<int64_t> const& keys,
+				  std::vector<uint32_t> const& children,
+				  std::vector<uint64_t> const& scalars);
+
+	template<typename T>
+	Range blob(boost::shared_ptr<T const> const& ptr);
+
+	std::map<Base const*, uint32_t> mObjectIndex;
+	std::map<trafo::Transformation const*, uint32_t> mTrafoIndex;
+
+	std::vector<Object> mObjects;
+	std::vector<int64_t> mKeys;
+	std::vector<uint32_t> mChildren;
+	std::vector<uint64_t> mScalars;
+	std::vector<Trafo> mTrafos;
+	std::vector<uint32_t> mTrafoChildren;
+	std::vector<double> mCoefficients;
+	std::string mBlobs;
+};
+
+uint32_t Writer::add(boost::shared_ptr<Base const> const& obj)
+{
+	if (!obj) {
+		return none;
+	}
+
+	auto const it = mObjectIndex.find(obj.get());
+	if (it != mObjectIndex.end()) {
+		return it->second;
+	}
+
+	Object record = Object();
+	record.type = objectType(typeid(*obj));
+	if (record.type == HICANN_COLLECTION) {
+		static_cast<HMF::HICANNCollection const&>(*obj).loadSections();
+	}
+
+	std::vector<int64_t> keys;
+	std::vector<uint32_t> children;
+	std::vector<uint64_t> scalars;
+
+	if (isCollection(record.type)) {
+		auto const& c = static_cast<Collection const&>(*obj);
+		for (auto const key : c.keys()) {
+			keys.push_back(key);
+			children.push_back(add(c.at(key)));
+		}
+	} else if (isCalibration(record.type)) {
+		auto const& c = static_cast<Calibration const&>(*obj);
+		for (size_t ii = 0; ii < c.size(); ++ii) {
+			keys.push_back(ii);
+			children.push_back(c.exists(ii) ? add(c.at(ii)) : none);
+		}
+	} else if (record.type == SYNAPSE_ROW_CALIBRATION) {
+		auto const& c = static_cast<HMF::SynapseRowCalibration const&>(*obj);
+		for (auto const& key : c.keys()) {
+			keys.push_back(key.get_sel_Vgmax() << 8 | key.get_gmax_div());
+			children.push_back(add(c.at(key)));
+		}
+	} else {
+		Range const range = blob(obj);
+		record.first = range.offset;
+		record.scalars = range.size;
+	}
+
+	switch (record.type) {
+		case NEURON_COLLECTION: {
+			auto const& c = static_cast<HMF::NeuronCollection const&>(*obj);
+			scalars = {c.getSpeedup(), c.getPLLFrequency(), c.getStartingCycle()};
+			break;
+		}
+		case HICANN_COLLECTION: {
+			auto const& c = static_cast<HMF::HICANNCollection const&>(*obj);
+			scalars = {c.getSpeedup(), c.getPLLFrequency(), c.getStartingCycle()};
+			break;
+		}
+		case L1_CROSSBAR_CALIBRATION: {
+			auto const& c = static_cast<HMF::L1CrossbarCalibration const&>(*obj);
+			scalars = {c.getMaxSwitchesPerRow(), c.getMaxSwitchesPerColumn()};
+			break;
+		}
+		case SYNAPSE_CHAIN_LENGTH_CALIBRATION: {
+			auto const& c = static_cast<HMF::SynapseChainLengthCalibration const&>(*obj);
+			scalars = {c.getMaxChainLength()};
+			break;
+		}
+		case SYNAPSE_SWITCH_CALIBRATION: {
+			auto const& c = static_cast<HMF::SynapseSwitchCalibration const&>(*obj);
+			scalars = {c.getMaxSwitches()};
+			break;
+		}
+		default:
+			break;
+	}
+
+	uint32_t const index = push(record, keys, children, scalars);
+	mObjectIndex[obj.get()] = index;
+	return index;
+}
+
+uint32_t Writer::add(boost::shared_ptr<trafo::Transformation const> const& t)
+{
+	using namespace trafo;
+
+	if (!t) {
+		return none;
+	}
+
+	auto const it = mTrafoIndex.find(t.get());
+	if (it != mTrafoIndex.end()) {
+		return it->second;
+	}
+
+	Trafo record = Trafo();
+	domain_type const domain = t->getDomain();
+	domain_type const reverse = t->getReverseDomain();
+	record.domain[0] = domain.lower();
+	record.domain[1] = domain.upper();
+	record.reverse_domain[0] = reverse.lower();
+	record.reverse_domain[1] = reverse.upper();
+	record.bounds = domain.bounds().bits() | reverse.bounds().bits() << 8;
+
+	std::type_info const& type = typeid(*t);
+	if (type == typeid(Constant)) {
+		record.type = CONSTANT;
+		record.first = mCoefficients.size();
+		record.count = 1;
+		mCoefficients.push_back(static_cast<Constant const&>(*t).getData());
+	} else if (type == typeid(Polynomial) || type == typeid(NegativePowersPolynomial)) {
+		auto const& data = static_cast<Polynomial const&>(*t).getData();
+		record.type = type == typeid(Polynomial) ? POLYNOMIAL : NEGATIVE_POWERS_POLYNOMIAL;
+		record.first = mCoefficients.size();
+		record.count = data.size();
+		mCoefficients.insert(mCoefficients.end(), data.begin(), data.end());
+	} else if (type == typeid(SumOfTrafos)) {
+		std::vector<uint32_t> children;
+		for (auto const& summand : static_cast<SumOfTrafos const&>(*t).getTrafos()) {
+			children.push_back(add(summand));
+		}
+		record.type = SUM_OF_TRAFOS;
+		record.first = mTrafoChildren.size();
+		record.count = children.size();
+		mTrafoChildren.insert(mTrafoChildren.end(), children.begin(), children.end());
+	} else if (type == typeid(PowerOfTrafo)) {
+		auto const& power = static_cast<PowerOfTrafo const&>(*t);
+		uint32_t const base = add(power.getTrafo());
+		record.type = POWER_OF_TRAFO;
+		record.first = mTrafoChildren.size();
+		record.count = 1;
+		record.power = power.getPower();
+		mTrafoChildren.push_back(base);
+	} else {
+		Range const range = blob(t);
+		if (range.size > std::numeric_limits<uint32_t>::max()) {
+			throw std::runtime_error("MmapBackend: transformation too large");
+		}
+		record.type = TRAFO_BLOB;
+		record.first = range.offset;
+		record.count = range.size;
+	}
+
+	uint32_t const index = mTrafos.size();
+	mTrafos.push_back(record);
+	mTrafoIndex[t.get()] = index;
+	return index;
+}
+
+uint32_t Writer::push(
+	Object record,
+	std::vector<int64_t> const& keys,
+	std::vector<uint32_t> const& children,
+	std::vector<uint64_t> const& scalars)
+{
+	if (record.type != OBJECT_BLOB) {
+		record.count = children.size();
+		record.first = mChildren.size();
+		record.scalars = mScalars.size();
+	}
+	mKeys.insert(mKeys.end(), keys.begin(), keys.end());
+	mChildren.insert(mChildren.end(), children.begin(), children.end());
+	mScalars.insert(mScalars.end(), scalars.begin(), scalars.end());
+
+	if (mObjects.size() >= none) {
+		throw std::runtime_error("MmapBackend: too many objects");
+	}
+	mObjects.push_back(record);
+	return mObjects.size() - 1;
+}
+
+template<typename T>
+Range Writer::blob(boost::shared_ptr<T const> const& ptr)
+{
+	std::ostringstream stream(std::ios::out | std::ios::binary);
+	{
+		boost::archive::binary_oarchive oa(stream);
+		oa << boost::serialization::make_nvp("blob", ptr);
+	}
+
+	Range range;
+	range.offset = mBlobs.size();
+	range.size = stream.str().size();
+	mBlobs += stream.str();
+	mBlobs.resize(align(mBlobs.size()), '\0');
+	return range;
+}
+
+void Writer::write(
+	std::string const& file,
+	MetaData const& metadata,
+	uint32_t const root) const
+{
+	Header header = Header();
+	std::memcpy(header.magic, magic, sizeof(magic));
+	header.version = version;
+	header.byte_order = byte_order;
+	header.root = root;
+
+	std::string strings;
+	MetaDataSaver saver(header.metadata, strings);
+	boost::serialization::access::serialize(saver, const_cast<MetaData&>(metadata), 0);
+
+	struct {
+		void const* data;
+		size_t size;
+	} const sections[NUM_SECTIONS] = {
+		{strings.data(), strings.size()},
+		{mObjects.data(), mObjects.size() * sizeof(Object)},
+		{mKeys.data(), mKeys.size() * sizeof(int64_t)},
+		{mChildren.data(), mChildren.size() * sizeof(uint32_t)},
+		{mScalars.data(), mScalars.size() * sizeof(uint64_t)},
+		{mTrafos.data(), mTrafos.size() * sizeof(Trafo)},
+		{mTrafoChildren.data(), mTrafoChildren.size() * sizeof(uint32_t)},
+		{mCoefficients.data(), mCoefficients.size() * sizeof(double)},
+		{mBlobs.data(), mBlobs.size()},
+	};
+
+	uint64_t offset = sizeof(Header);
+	for (size_t ii = 0; ii < NUM_SECTIONS; ++ii) {
+		header.sections[ii].offset = offset;
+		header.sections[ii].size = sections[ii].size;
+		offset = align(offset + sections[ii].size);
+	}
+	header.file_size = offset;
+
+	// written next to the target and renamed, readers never see partial files
+	std::string const tmp = file + ".tmp";
+	{
+		std::ofstream stream(tmp, std::ios::out | std::ios::binary | std::ios::trunc);
+		char const padding[8] = {};
+		stream.write(reinterpret_cast<char const*>(&header), sizeof(header));
+		for (size_t ii = 0; ii < NUM_SECTIONS; ++ii) {
+			stream.write(static_cast<char const*>(sections[ii].data), sections[ii].size);
+			stream.write(padding, align(sections[ii].size) - sections[ii].size);
+		}
+		if (!stream) {
+			throw std::runtime_error("MmapBackend: cannot write " + tmp);
+		}
+	}
+	boost::filesystem::rename(tmp, file);
+}
+
+
+/// creates the objects of a mapped file on first use, indices are checked
+/// before use
+class Reader
+{
+public:
+	explicit Reader(boost::shared_ptr<Mapping const> const& mapping);
+
+	void metadata(MetaData& metadata) const;
+
+	/// creates the stored object and everything it refers to
+	boost::shared_ptr<Base> root();
+
+	/// null if a null pointer was stored
+	Object const* rootRecord() const;
+
+	/// members of @param record besides its children
+	uint64_t const* scalars(Object const& record) const;
+
+	/// creates the entry with @param key of the stored collection and
+	/// everything it refers to, null if there is none. Thread-safe.
+	boost::shared_ptr<Base> rootEntry(int64_t key);
+
+	/// creates the stored collection with the entries in @param keys only,
+	/// null if no collection is stored
+	boost::shared_ptr<Collection> rootEntries(std::vector<int> const& keys);
+
+private:
+	template<typename T>
+	struct Array
+	{
+		T const* data;
+		size_t size;
+	};
+
+	template<typename T>
+	Array<T> section(Section s) const;
+
+	boost::shared_ptr<trafo::Transformation> trafo(uint32_t index);
+	boost::shared_ptr<Base> object(uint32_t index);
+
+	/// empty collection of the type of @param record with its scalars
+	boost::shared_ptr<Collection> collection(Object const& record) const;
+
+	/// position of @param key in KEYS and CHILDREN, none if @param record
+	/// has no child with this key
+	uint64_t find(Object const& record, int64_t key) const;
+
+	void checkChildren(Object const& record) const;
+
+	/// the transformation or object with @param index, which has to precede
+	/// @param parent
+	boost::shared_ptr<trafo::Transformation> trafoAt(uint32_t index, size_t parent);
+	boost::shared_ptr<Base> objectAt(uint32_t index, size_t parent);
+
+	template<typename T>
+	boost::shared_ptr<T> blob(uint64_t offset, uint64_t size) const;
+
+	Header const& header() const;
+
+	boost::shared_ptr<Mapping const> mMapping;
+
+	Array<char> mStrings;
+	Array<Object> mObjectRecords;
+	Array<int64_t> mKeys;
+	Array<uint32_t> mChildren;
+	Array<uint64_t> mScalars;
+	Array<Trafo> mTrafoRecords;
+	Array<uint32_t> mTrafoChildren;
+	Array<double> mCoefficients;
+	Array<char> mBlobs;
+
+	// created so far, shared objects are created once
+	std::vector<boost::shared_ptr<trafo::Transformation> > mTrafos;
+	std::vector<boost::shared_ptr<Base> > mObjects;
+	std::vector<bool> mTrafoCreated;
+	std::vector<bool> mObjectCreated;
+
+	std::mutex mMutex;
+};
+
+Reader::Reader(boost::shared_ptr<Mapping const> const& mapping) :
+	mMapping(mapping)
+{
+	if (mapping->size() < sizeof(Header) ||
+		std::memcmp(header().magic, magic, sizeof(magic)) != 0) {
+		throw std::runtime_error("MmapBackend: not a calibtic mmap file");
+	}
+	if (header().version != version) {
+		throw std::runtime_error("MmapBackend: unsupported file version");
+	}
+	if (header().byte_order != byte_order) {
+		throw std::runtime_error("MmapBackend: file written with different byte order");
+	}
+	if (header().file_size != mapping->size()) {
+		corrupt("truncated");
+	}
+
+	mStrings = section<char>(STRINGS);
+	mObjectRecords = section<Object>(OBJECTS);
+	mKeys = section<int64_t>(KEYS);
+	mChildren = section<uint32_t>(CHILDREN);
+	mScalars = section<uint64_t>(SCALARS);
+	mTrafoRecords = section<Trafo>(TRAFOS);
+	mTrafoChildren = section<uint32_t>(TRAFO_CHILDREN);
+	mCoefficients = section<double>(COEFFICIENTS);
+	mBlobs = section<char>(BLOBS);
+
+	if (mKeys.size != mChildren.size) {
+		corrupt("keys and children differ in size");
+	}
+	if (header().root != none && header().root >= mObjectRecords.size) {
+		corrupt("object index out of range");
+	}
+
+	mTrafos.resize(mTrafoRecords.size);
+	mTrafoCreated.resize(mTrafoRecords.size, false);
+	mObjects.resize(mObjectRecords.size);
+	mObjectCreated.resize(mObjectRecords.size, false);
+}
+
+Header const& Reader::header() const
+{
+	return *reinterpret_cast<Header const*>(mMapping->data());
+}
+
+template<typename T>
+Reader::Array<T> Reader::section(Section const s) const
+{
+	Range const& range = header().sections[s];
+	if (range.offset % 8 != 0 || range.offset > mMapping->size() ||
+		range.size > mMapping->size() - range.offset || range.size % sizeof(T) != 0) {
+		corrupt("section out of range");
+	}
+
+	Array<T> res;
+	res.data = reinterpret_cast<T const*>(mMapping->data() + range.offset);
+	res.size = range.size / sizeof(T);
+	return res;
+}
+
+void Reader::metadata(MetaData& metadata) const
+{
+	MetaDataLoader loader(header().metadata, mStrings.data, mStrings.size);
+	boost::serialization::access::serialize(loader, metadata, 0);
+}
+
+boost::shared_ptr<Base> Reader::root()
+{
+	return objectAt(header().root, mObjectRecords.size);
+}
+
+Object const* Reader::rootRecord() const
+{
+	return header().root == none ? nullptr : mObjectRecords.data + header().root;
+}
+
+uint64_t const* Reader::scalars(Object const& record) const
+{
+	if (record.scalars > mScalars.size ||
+		scalarCount(record.type) > mScalars.size - record.scalars) {
+		corrupt("object scalars out of range");
+	}
+	return mScalars.data + record.scalars;
+}
+
+boost::shared_ptr<Base> Reader::rootEntry(int64_t const key)
+{
+	Object const* record = rootRecord();
+	if (!record || !isCollection(record->type)) {
+		corrupt("stored object is no collection");
+	}
+
+	uint64_t const pos = find(*record, key);
+	if (pos == none) {
+		return boost::shared_ptr<Base>();
+	}
+	std::lock_guard<std::mutex> lock(mMutex);
+	return objectAt(mChildren.data[pos], header().root);
+}
+
+boost::shared_ptr<Collection> Reader::rootEntries(std::vector<int> const& keys)
+{
+	Object const* record = rootRecord();
+	if (!record || !isCollection(record->type)) {
+		return boost::shared_ptr<Collection>();
+	}
+
+	std::vector<int> unique(keys);
+	std::sort(unique.begin(), unique.end());
+	unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+
+	Collection entries;
+	for (auto const key : unique) {
+		uint64_t const pos = find(*record, key);
+		if (pos != none) {
+			entries.insert(key, objectAt(mChildren.data[pos], header().root));
+		}
+	}
+
+	auto const res = collection(*record);
+	res->Collection::copy(entries);
+	return res;
+}
+
+void Reader::checkChildren(Object const& record) const
+{
+	if (record.first > mChildren.size || record.count > mChildren.size - record.first) {
+		corrupt("object children out of range");
+	}
+}
+
+uint64_t Reader::find(Object const& record, int64_t const key) const
+{
+	checkChildren(record);
+	int64_t const* begin = mKeys.data + record.first;
+	int64_t const* end = begin + record.count;
+	int64_t const* it = std::lower_bound(begin, end, key);
+	if (it == end || *it != key) {
+		return none;
+	}
+	return it - mKeys.data;
+}
+
+boost::shared_ptr<trafo::Transformation>
+Reader::trafoAt(uint32_t const index, size_t const parent)
+{
+	if (index == none) {
+		return boost::shared_ptr<trafo::Transformation>();
+	}
+	// also rules out cycles in corrupt files
+	if (index >= parent || index >= mTrafos.size()) {
+		corrupt("transformation index out of range");
+	}
+	if (!mTrafoCreated[index]) {
+		mTrafos[index] = trafo(index);
+		mTrafoCreated[index] = true;
+	}
+	return mTrafos[index];
+}
+
+boost::shared_ptr<Base> Reader::objectAt(uint32_t const index, size_t const parent)
+{
+	if (index == none) {
+		return boost::shared_ptr<Base>();
+	}
+	if (index >= parent || index >= mObjects.size()) {
+		corrupt("object index out of range");
+	}
+	if (!mObjectCreated[index]) {
+		mObjects[index] = object(index);
+		mObjectCreated[index] = true;
+	}
+	return mObjects[index];
+}
+
+template<typename T>
+boost::shared_ptr<T> Reader::blob(uint64_t const offset, uint64_t const size) const
+{
+	if (offset > mBlobs.size || size > mBlobs.size - offset) {
+		corrupt("blob out of range");
+	}
+
+	namespace io = boost::iostreams;
+	io::stream<io::array_source> stream(mBlobs.data + offset, size);
+	boost::archive::binary_iarchive ia(stream);
+
+	boost::shared_ptr<T> ptr;
+	ia >> boost::serialization::make_nvp("blob", ptr);
+	return ptr;
+}
+
+boost::shared_ptr<Collection> Reader::collection(Object const& record) const
+{
+	using namespace HMF;
+
+	uint64_t const* scalars = this->scalars(record);
+	boost::shared_ptr<Collection> res;
+	switch (record.type) {
+		case COLLECTION:
+			res = boost::make_shared<Collection>();
+			break;
+		case NEURON_COLLECTION: {
+			auto const c = boost::make_shared<NeuronCollection>();
+			c->setSpeedup(scalars[0]);
+			c->setPLLFrequency(scalars[1]);
+			c->setStartingCycle(scalars[2]);
+			res = c;
+			break;
+		}
+		case HICANN_COLLECTION: {
+			auto const c = boost::make_shared<HICANNCollection>();
+			c->setSpeedup(scalars[0]);
+			c->setPLLFrequency(scalars[1]);
+			c->setStartingCycle(scalars[2]);
+			res = c;
+			break;
+		}
+		case BLOCK_COLLECTION:
+			res = boost::make_shared<BlockCollection>();
+			break;
+		case SYNAPSE_ROW_COLLECTION:
+			res = boost::make_shared<SynapseRowCollection>();
+			break;
+		case L1_CROSSBAR_COLLECTION:
+			res = boost::make_shared<L1CrossbarCollection>();
+			break;
+		case SYNAPSE_CHAIN_LENGTH_COLLECTION:
+			res = boost::make_shared<SynapseChainLengthCollection>();
+			break;
+		case SYNAPSE_SWITCH_COLLECTION:
+			res = boost::make_shared<SynapseSwitchCollection>();
+			break;
+	}
+	if (!res) {
+		corrupt("unknown collection type");
+	}
+	return res;
+}
+
+boost::shared_ptr<trafo::Transformation> Reader::trafo(uint32_t const index)
+{
+	using namespace trafo;
+
+	Trafo const& record = mTrafoRecords.data[index];
+
+	boost::shared_ptr<Transformation> res;
+
+	if (record.type == CONSTANT || record.type == POLYNOMIAL ||
+		record.type == NEGATIVE_POWERS_POLYNOMIAL) {
+		if (record.first > mCoefficients.size ||
+			record.count > mCoefficients.size - record.first) {
+			corrupt("coefficients out of range");
+		}
+	} else if (record.type == SUM_OF_TRAFOS || record.type == POWER_OF_TRAFO) {
+		if (record.first > mTrafoChildren.size ||
+			record.count > mTrafoChildren.size - record.first) {
+			corrupt("transformation children out of range");
+		}
+	}
+	double const* coefficients = mCoefficients.data + record.first;
+	uint32_t const* children = mTrafoChildren.data + record.first;
+
+	switch (record.type) {
+		case TRAFO_BLOB:
+			// domains are part of the archive
+			return blob<Transformation>(record.first, record.count);
+		case CONSTANT: {
+			if (record.count != 1) {
+				corrupt("constant without value");
+			}
+			res = boost::make_shared<Constant>(coefficients[0]);
+			break;
+		}
+		case POLYNOMIAL: {
+			auto const p = boost::make_shared<Polynomial>();
+			p->getData().assign(coefficients, coefficients + record.count);
+			res = p;
+			break;
+		}
+		case NEGATIVE_POWERS_POLYNOMIAL: {
+			auto const p = boost::make_shared<NegativePowersPolynomial>();
+			p->getData().assign(coefficients, coefficients + record.count);
+			res = p;
+			break;
+		}
+		case SUM_OF_TRAFOS: {
+			SumOfTrafos::trafo_list summands;
+			for (size_t ii = 0; ii < record.count; ++ii) {
+				summands.push_back(trafoAt(children[ii], index));
+			}
+			res = boost::make_shared<SumOfTrafos>(summands);
+			break;
+		}
+		case POWER_OF_TRAFO: {
+			if (record.count != 1) {
+				corrupt("power without base");
+			}
+			res = boost::make_shared<PowerOfTrafo>(record.power, trafoAt(children[0], index));
+			break;
+		}
+		default:
+			corrupt("unknown transformation type");
+	}
+
+	using boost::icl::interval_bounds;
+	res->getDomain() = domain_type(record.domain[0], record.domain[1],
+		interval_bounds(record.bounds & 0xff));
+	res->getReverseDomain() = domain_type(record.reverse_domain[0], record.reverse_domain[1],
+		interval_bounds(record.bounds >> 8 & 0xff));
+	return res;
+}
+
+boost::shared_ptr<Base> Reader::object(uint32_t const index)
+{
+	using namespace HMF;
+
+	Object const& record = mObjectRecords.data[index];
+
+	if (record.type == OBJECT_BLOB) {
+		return blob<Base>(record.first, record.scalars);
+	}
+
+	checkChildren(record);
+	int64_t const* keys = mKeys.data + record.first;
+	uint32_t const* children = mChildren.data + record.first;
+	uint64_t const* scalars = this->scalars(record);
+
+	if (isCollection(record.type)) {
+		// replaces the entries created by default constructors
+		Collection entries;
+		for (size_t ii = 0; ii < record.count; ++ii) {
+			entries.insert(keys[ii], objectAt(children[ii], index));
+		}
+
+		auto const res = collection(record);
+		res->Collection::copy(entries);
+		return res;
+	}
+
+	if (isCalibration(record.type)) {
+		Calibration trafos(record.count);
+		for (size_t ii = 0; ii < record.count; ++ii) {
+			trafos.reset(ii, trafoAt(children[ii], mTrafoRecords.size));
+		}
+
+		boost::shared_ptr<Calibration> res;
+		switch (record.type) {
+			case CALIBRATION:
+				res = boost::make_shared<Calibration>();
+				break;
+			case NEURON_CALIBRATION:
+				res = boost::make_shared<NeuronCalibration>();
+				break;
+			case SHARED_CALIBRATION:
+				res = boost::make_shared<SharedCalibration>();
+				break;
+			case SYNAPSE_CALIBRATION:
+				res = boost::make_shared<SynapseCalibration>();
+				break;
+			case ADC_CALIBRATION:
+				res = boost::make_shared<ADC::ADCCalibration>();
+				break;
+			case L1_CROSSBAR_CALIBRATION: {
+				auto const c = boost::make_shared<L1CrossbarCalibration>();
+				c->setMaxSwitchesPerRow(scalars[0]);
+				c->setMaxSwitchesPerColumn(scalars[1]);
+				res = c;
+				break;
+			}
+			case SYNAPSE_CHAIN_LENGTH_CALIBRATION: {
+				auto const c = boost::make_shared<SynapseChainLengthCalibration>();
+				c->setMaxChainLength(scalars[0]);
+				res = c;
+				break;
+			}
+			case SYNAPSE_SWITCH_CALIBRATION: {
+				auto const c = boost::make_shared<SynapseSwitchCalibration>();
+				c->setMaxSwitches(scalars[0]);
+				res = c;
+				break;
+			}
+		}
+		res->Calibration::copy(trafos);
+		return res;
+	}
+
+	if (record.type == SYNAPSE_ROW_CALIBRATION) {
+		auto const res = boost::make_shared<SynapseRowCalibration>();
+		for (size_t ii = 0; ii < record.count; ++ii) {
+			auto const child = objectAt(children[ii], index);
+			auto const synapse = boost::dynamic_pointer_cast<SynapseCalibration>(child);
+			if (child && !synapse) {
+				corrupt("synapse row calibration entry of wrong type");
+			}
+			res->insert(GmaxConfig(keys[ii] >> 8 & 0xff, keys[ii] & 0xff), synapse);
+		}
+		return res;
+	}
+
+	corrupt("unknown object type");
+	return boost::shared_ptr<Base>();
+}
+
+boost::shared_ptr<Reader> openDataSet(boost::filesystem::path const& file)
+{
+	if (!boost::filesystem::exists(file)) {
+		LOG4CXX_ERROR(logger, "Calibration file does not exist: " << file);
+		throw std::runtime_error(
+		    std::string("data set not found: ") + file.string());
+	}
+	return boost::make_shared<Reader>(
+		boost::make_shared<Mapping const>(file.string()));
+}
+
+/// stored HICANNCollection whose sub-collections are created on first access
+boost::shared_ptr<Base> lazyHICANNCollection(
+	boost::shared_ptr<Reader> const& reader,
+	boost::shared_ptr<trafo::Pool> const& pool)
+{
+	uint64_t const* scalars = reader->scalars(*reader->rootRecord());
+	auto const res = boost::make_shared<HMF::HICANNCollection>();
+	res->setSpeedup(scalars[0]);
+	res->setPLLFrequency(scalars[1]);
+	res->setStartingCycle(scalars[2]);
+
+	// keeps the file mapped as long as the collection or a copy of it exists
+	res->setSectionLoader([reader, pool](Collection::key_type const key) {
+		auto const section = reader->rootEntry(key);
+		if (section && !dynamic_cast<Collection const*>(section.get())) {
+			corrupt("HICANNCollection entry of wrong type");
+		}
+		if (section && pool) {
+			section->intern(*pool);
+		}
+		return section;
+	});
+	return res;
+}
+
+} // namespace
+
+
+MmapBackend::MmapBackend() :
+	mPath(".") {}
+
+MmapBackend::~MmapBackend()
+{
+	// pending asynchronous operations use this object
+	wait();
+}
+
+MmapBackend::path& MmapBackend::getPath()
+{
+	return mPath;
+}
+
+MmapBackend::path const& MmapBackend::getPath() const
+{
+	return mPath;
+}
+
+void MmapBackend::init()
+{
+	namespace fs = boost::filesystem;
+	if (exists("path")) {
+		getPath() = get<std::string>("path");
+		if (!fs::is_directory(getPath())) {
+			std::stringstream err;
+			err << "MmapBackend::init(): path " << getPath() << " not available";
+			throw std::runtime_error(err.str());
+		}
+	}
+	// files are mapped and read in place, which compressed files cannot be
+	if (exists("compression")) {
+		throw std::runtime_error("MmapBackend::init(): compression is not supported");
+	}
+}
+
+template<typename T>
+void MmapBackend::load(std::string const& id,
+					   MetaData& metadata,
+					   boost::shared_ptr<T>& t)
+{
+	auto const file = getFilename(id, metadata);
+	auto const reader = openDataSet(file);
+	reader->metadata(metadata);
+
+	bool const lazy = exists("lazy") && get<int>("lazy") && reader->rootRecord() &&
+		reader->rootRecord()->type == HICANN_COLLECTION;
+	boost::shared_ptr<Base> const base = lazy ?
+		lazyHICANNCollection(reader, getPool()) : reader->root();
+	t = boost::dynamic_pointer_cast<T>(base);
+	if (base && !t) {
+		throw std::runtime_error(
+		    std::string("data set of different type: ") + file.string());
+	}
+
+	// lazily loaded sections are interned by the section loader
+	if (t && !lazy) {
+		deduplicate(*t);
+	}
+}
+
+void MmapBackend::store(std::string const& id,
+						MetaData const& metadata,
+						boost::shared_ptr<Base const> t)
+{
+	Writer writer;
+	uint32_t const root = writer.add(t);
+	writer.write(getFilename(id, metadata).string(), metadata, root);
+}
+
+void MmapBackend::load(
+	std::string const& id,
+	MetaData& metadata,
+	Collection& c)
+{
+	LOG4CXX_DEBUG(logger, "Load Collection " + id);
+	boost::shared_ptr<Collection> ptr;
+	load(id, metadata, ptr);
+	if (!ptr) {
+		throw std::runtime_error("no collection stored in data set " + id);
+	}
+	c.copy(*ptr);
+}
+
+void MmapBackend::load(
+	std::string const& id,
+	MetaData& metadata,
+	Calibration& c)
+{
+	LOG4CXX_DEBUG(logger, "Load Calibration " + id);
+	boost::shared_ptr<Calibration> ptr;
+	load(id, metadata, ptr);
+	if (!ptr) {
+		throw std::runtime_error("no calibration stored in data set " + id);
+	}
+	c.copy(*ptr);
+}
+
+void MmapBackend::load(std::string const& id,
+	 MetaData& metadata,
+	 boost::shared_ptr<Calibration> & ptr)
+{
+	LOG4CXX_DEBUG(logger, "Load Calibration " + id);
+	load<Calibration>(id, metadata, ptr);
+}
+
+void MmapBackend::load(
+	std::string const& id,
+	MetaData& metadata,
+	Collection& c,
+	std::vector<int> const& keys)
+{
+	LOG4CXX_DEBUG(logger, "Load entries of Collection " + id);
+	auto const file = getFilename(id, metadata);
+	auto const reader = openDataSet(file);
+	reader->metadata(metadata);
+
+	auto const ptr = reader->rootEntries(keys);
+	if (!ptr) {
+		throw std::runtime_error("no collection stored in data set " + id);
+	}
+	deduplicate(*ptr);
+	c.copy(*ptr);
+}
+
+void MmapBackend::store(
+	std::string const& id,
+	MetaData const& metadata,
+	Collection const& set)
+{
+	using boost::serialization::null_deleter;
+	store(id, metadata, boost::shared_ptr<Base const>(&set, null_deleter()));
+}
+
+void MmapBackend::store(
+	std::string const& id,
+	MetaData const& metadata,
+	Calibration const& set)
+{
+	using boost::serialization::null_deleter;
+	store(id, metadata, boost::shared_ptr<Base const>(&set, null_deleter()));
+}
+
+void MmapBackend::store(std::string const& id,
+	 MetaData const& metadata,
+	 boost::shared_ptr<const Calibration> ptr)
+{
+	store(id, metadata, boost::shared_ptr<Base const>(ptr));
+}
+
+MmapBackend::path
+MmapBackend::getFilename(
+	std::string const& id,
+	MetaData const&) const
+{
+	return getPath() / (id + ".cmap");
+}
+
+} // backend
+} // calibtic
+
+
+extern "C" {
+
+backend_t* createBackend()
+{
+	return new calibtic::backend::MmapBackend();
+}
+
+void destroyBackend(backend_t* backend)
+{
+	delete backend;
+}
+
+} // extern "C"
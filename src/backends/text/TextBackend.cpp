@@ -16,9 +16,13 @@ log4cxx::LoggerPtr logger = log4cxx::Logger::getLogger("Calibtic");
 
 
 TextBackend::TextBackend() :
-	mPath(".") {}
+	mPath("."), mCompression(Compression::none) {}
 
-TextBackend::~TextBackend() {}
+TextBackend::~TextBackend()
+{
+	// pending asynchronous operations use this object
+	wait();
+}
 
 TextBackend::path& TextBackend::getPath()
 {
@@ -41,6 +45,9 @@ void TextBackend::init()
 			throw std::runtime_error(err.str());
 		}
 	}
+	if (exists("compression")) {
+		mCompression = compression(get<std::string>("compression"));
+	}
 }
 
 void TextBackend::load(
@@ -16,9 +16,13 @@ log4cxx::LoggerPtr logger = log4cxx::Logger::getLogger("Calibtic");
 
 
 XMLBackend::XMLBackend() :
-	mPath(".") {}
+	mPath("."), mCompression(Compression::none) {}
 
-XMLBackend::~XMLBackend() {}
+XMLBackend::~XMLBackend()
+{
+	// pending asynchronous operations use this object
+	wait();
+}
 
 XMLBackend::path& XMLBackend::getPath()
 {
@@ -41,6 +45,9 @@ void XMLBackend::init()
 			throw std::runtime_error(err.str());
 		}
 	}
+	if (exists("compression")) {
+		mCompression = compression(get<std::string>("compression"));
+	}
 }
 
 void XMLBackend::load(
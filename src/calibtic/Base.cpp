@@ -6,6 +6,8 @@ namespace calibtic {
 
 Base::~Base() {}
 
+void Base::intern(trafo::Pool&) {}
+
 std::ostream& operator<< (std::ostream& os, Base const& t)
 {
 	return t.operator<<(os);
@@ -1,6 +1,8 @@
 #include "calibtic/Calibration.h"
 #include "calibtic/trafo/Transformation.h"
+#include "calibtic/trafo/Pool.h"
 
+#include <cassert>
 #include <sstream>
 #include <iostream>
 
@@ -111,6 +113,35 @@ void Calibration::copy(Calibration const& rhs)
 	*this = rhs;
 }
 
+void Calibration::intern(trafo::Pool& pool)
+{
+	for (auto& trafo : mTrafo) {
+		trafo = pool.intern(trafo);
+	}
+}
+
+void Calibration::applyMany(
+    float_type const* in, float_type* out, size_t n, key_type const offset,
+    trafo_t::OutsideDomainBehavior outside_domain_behavior) const
+{
+	assert(mTrafo.size() > offset);
+
+	value_type const& val = mTrafo[offset];
+	handleUninitialized(static_cast<bool>(val));
+
+	val->apply(in, out, n, outside_domain_behavior);
+}
+
+void Calibration::reverseApplyMany(
+    float_type const* in, float_type* out, size_t n, key_type const offset,
+    trafo_t::OutsideDomainBehavior outside_domain_behavior) const
+{
+	value_type const& val = mTrafo.at(offset);
+	handleUninitialized(static_cast<bool>(val));
+
+	val->reverseApply(in, out, n, outside_domain_behavior);
+}
+
 void Calibration::handleUninitialized(bool const init) const
 {
 	if (!init) {
@@ -41,6 +41,16 @@ Collection::size() const
 	return mBases.size();
 }
 
+std::vector<Collection::key_type> Collection::keys() const
+{
+	std::vector<key_type> res;
+	res.reserve(mBases.size());
+	for (auto const& pair : mBases) {
+		res.push_back(pair.first);
+	}
+	return res;
+}
+
 
 bool Collection::exists(key_type const& key) const
 {
@@ -88,6 +98,15 @@ void Collection::copy(Collection const& rhs)
 	*this = rhs;
 }
 
+void Collection::intern(trafo::Pool& pool)
+{
+	for (auto& pair : mBases) {
+		if (pair.second) {
+			pair.second->intern(pool);
+		}
+	}
+}
+
 std::ostream& operator<< (std::ostream& os, Collection const& t)
 {
 	return t.operator<<(os);
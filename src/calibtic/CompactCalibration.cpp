@@ -0,0 +1,291 @@
+#include "calibtic/CompactCalibration.h"
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <typeinfo>
+#include <log4cxx/logger.h>
+
+#include "calibtic/trafo/Constant.h"
+#include "calibtic/trafo/Domain.h"
+#include "calibtic/trafo/Horner.h"
+#include "calibtic/trafo/NegativePowersPolynomial.h"
+#include "calibtic/trafo/Polynomial.h"
+
+namespace calibtic {
+
+static log4cxx::LoggerPtr _log = log4cxx::Logger::getLogger("Calibtic");
+
+CompactCalibration::CompactCalibration() :
+	mBegin(1, 0)
+{
+}
+
+CompactCalibration::CompactCalibration(Calibration const& calib) :
+	mBegin(1, 0)
+{
+	push_back(calib);
+}
+
+CompactCalibration::size_type
+CompactCalibration::push_back(Calibration const& calib)
+{
+	size_t const entries = mKind.size() + calib.size();
+	if (entries > std::numeric_limits<uint32_t>::max()) {
+		throw std::runtime_error("CompactCalibration: too many transformations");
+	}
+
+	for (key_type key = 0; key < calib.size(); ++key) {
+		Calibration::const_value_type trafo;
+		if (calib.exists(key)) {
+			trafo = calib.at(key);
+		}
+
+		Kind kind = FALLBACK;
+		float_type lower = CALIBTIC_DOMAIN_MIN;
+		float_type upper = CALIBTIC_DOMAIN_MAX;
+		uint32_t const offset = mCoefficients.size();
+
+		if (!trafo) {
+			kind = UNINITIALIZED;
+		} else {
+			domain_type const domain = trafo->getDomain();
+			// only exact types, derived classes may change apply
+			std::type_info const& type = typeid(*trafo);
+			if (type == typeid(trafo::Constant)) {
+				kind = CONSTANT;
+				mCoefficients.push_back(
+				    static_cast<trafo::Constant const&>(*trafo).getData());
+			} else if (domain.bounds() != boost::icl::interval_bounds::closed()) {
+				kind = FALLBACK;
+			} else if (type == typeid(trafo::Polynomial) ||
+			           type == typeid(trafo::NegativePowersPolynomial)) {
+				kind = (type == typeid(trafo::Polynomial)) ? POLYNOMIAL : NEGATIVE_POWERS;
+				trafo::Polynomial::data_type const& data =
+				    static_cast<trafo::Polynomial const&>(*trafo).getData();
+				mCoefficients.insert(mCoefficients.end(), data.begin(), data.end());
+				lower = domain.lower();
+				upper = domain.upper();
+			}
+		}
+
+		mKind.push_back(kind);
+		mLower.push_back(lower);
+		mUpper.push_back(upper);
+		mOffset.push_back(offset);
+		mCount.push_back(mCoefficients.size() - offset);
+		mTrafos.push_back(trafo);
+	}
+
+	if (mCoefficients.size() > std::numeric_limits<uint32_t>::max()) {
+		throw std::runtime_error("CompactCalibration: too many coefficients");
+	}
+
+	mBegin.push_back(mKind.size());
+	return size() - 1;
+}
+
+CompactCalibration::size_type
+CompactCalibration::size() const
+{
+	return mBegin.size() - 1;
+}
+
+CompactCalibration::size_type
+CompactCalibration::size(size_type const index) const
+{
+	return mBegin.at(index + 1) - mBegin.at(index);
+}
+
+bool CompactCalibration::exists(size_type const index, key_type const key) const
+{
+	return mKind[entry(index, key)] != UNINITIALIZED;
+}
+
+size_t CompactCalibration::entry(size_type const index, key_type const key) const
+{
+	if (key >= size(index)) {
+		std::stringstream message;
+		message << "CompactCalibration: no transformation " << key
+		        << " in calibration " << index;
+		throw std::out_of_range(message.str());
+	}
+	return mBegin[index] + key;
+}
+
+float_type CompactCalibration::respectDomain(
+    size_t const entry, float_type const in,
+    trafo_t::OutsideDomainBehavior outside_domain_behavior) const
+{
+	float_type const lower = mLower[entry];
+	float_type const upper = mUpper[entry];
+
+	if (lower <= in && in <= upper) {
+		return in;
+	}
+
+	// same as Transformation::respectDomain
+	switch (outside_domain_behavior) {
+		case trafo_t::THROW: {
+			std::stringstream err_msg;
+			err_msg << "Value " << in << " outside of domain "
+			        << mTrafos[entry]->getDomain();
+			throw OutsideDomainException(err_msg.str());
+		}
+		case trafo_t::CLIP: {
+			float_type const val = (in <= lower) ? lower : upper;
+			LOG4CXX_WARN(_log, "Transformation::respectDomain: input value "
+			                       << in << " outside of domain "
+			                       << mTrafos[entry]->getDomain()
+			                       << ", clipped to " << val << ".");
+			return val;
+		}
+		case trafo_t::IGNORE:
+			break;
+	}
+	return in;
+}
+
+void CompactCalibration::respectDomain(
+    size_t const entry, float_type const* in, float_type* out, size_t n,
+    trafo_t::OutsideDomainBehavior outside_domain_behavior) const
+{
+	float_type const lower = mLower[entry];
+	float_type const upper = mUpper[entry];
+
+	// same as Transformation::respectDomain
+	switch (outside_domain_behavior) {
+		case trafo_t::THROW: {
+			for (size_t ii = 0; ii < n; ++ii) {
+				if (!(lower <= in[ii] && in[ii] <= upper)) {
+					std::stringstream err_msg;
+					err_msg << "Value " << in[ii] << " outside of domain "
+					        << mTrafos[entry]->getDomain();
+					throw OutsideDomainException(err_msg.str());
+				}
+			}
+			if (in != out) {
+				std::copy(in, in + n, out);
+			}
+			break;
+		}
+		case trafo_t::CLIP: {
+			size_t clipped = 0;
+			for (size_t ii = 0; ii < n; ++ii) {
+				float_type const val = in[ii];
+				if (lower <= val && val <= upper) {
+					out[ii] = val;
+				} else {
+					out[ii] = (val <= lower) ? lower : upper;
+					++clipped;
+				}
+			}
+			if (clipped) {
+				LOG4CXX_WARN(_log, "Transformation::respectDomain: "
+				                       << clipped << " of " << n
+				                       << " input values outside of domain "
+				                       << mTrafos[entry]->getDomain() << ", clipped.");
+			}
+			break;
+		}
+		case trafo_t::IGNORE:
+			if (in != out) {
+				std::copy(in, in + n, out);
+			}
+			break;
+	}
+}
+
+float_type CompactCalibration::apply(
+    size_type const index, key_type const key, float_type const in,
+    trafo_t::OutsideDomainBehavior outside_domain_behavior) const
+{
+	size_t const e = entry(index, key);
+	float_type const* const coeff = mCoefficients.data() + mOffset[e];
+
+	switch (mKind[e]) {
+		case CONSTANT:
+			return coeff[0];
+		case POLYNOMIAL:
+			return trafo::horner::evaluate(
+			    coeff, mCount[e], respectDomain(e, in, outside_domain_behavior));
+		case NEGATIVE_POWERS:
+			static_cast<trafo::NegativePowersPolynomial const&>(*mTrafos[e]).checkInput(&in, 1);
+			return trafo::horner::evaluate_negative_powers(
+			    coeff, mCount[e], respectDomain(e, in, outside_domain_behavior));
+		case FALLBACK:
+			return mTrafos[e]->apply(in, outside_domain_behavior);
+		case UNINITIALIZED:
+			break;
+	}
+	throw std::runtime_error("uninitialized data");
+}
+
+float_type CompactCalibration::reverseApply(
+    size_type const index, key_type const key, float_type const in,
+    trafo_t::OutsideDomainBehavior outside_domain_behavior) const
+{
+	size_t const e = entry(index, key);
+	if (mKind[e] == UNINITIALIZED) {
+		throw std::runtime_error("uninitialized data");
+	}
+	return mTrafos[e]->reverseApply(in, outside_domain_behavior);
+}
+
+void CompactCalibration::apply(
+    size_type const index, key_type const key, float_type const* in,
+    float_type* out, size_t n,
+    trafo_t::OutsideDomainBehavior outside_domain_behavior) const
+{
+	size_t const e = entry(index, key);
+	float_type const* const coeff = mCoefficients.data() + mOffset[e];
+
+	switch (mKind[e]) {
+		case CONSTANT:
+			std::fill(out, out + n, coeff[0]);
+			return;
+		case POLYNOMIAL:
+			respectDomain(e, in, out, n, outside_domain_behavior);
+			trafo::horner::evaluate(coeff, mCount[e], out, out, n);
+			return;
+		case NEGATIVE_POWERS:
+			static_cast<trafo::NegativePowersPolynomial const&>(*mTrafos[e]).checkInput(in, n);
+			respectDomain(e, in, out, n, outside_domain_behavior);
+			trafo::horner::evaluate_negative_powers(coeff, mCount[e], out, out, n);
+			return;
+		case FALLBACK:
+			mTrafos[e]->apply(in, out, n, outside_domain_behavior);
+			return;
+		case UNINITIALIZED:
+			break;
+	}
+	throw std::runtime_error("uninitialized data");
+}
+
+size_t CompactCalibration::memory() const
+{
+	return mBegin.size() * sizeof(uint32_t) +
+	       mKind.size() * (sizeof(Kind) + 2 * sizeof(float_type) + 2 * sizeof(uint32_t)) +
+	       mCoefficients.size() * sizeof(float_type);
+}
+
+std::ostream& CompactCalibration::operator<< (std::ostream& os) const
+{
+	os << "CompactCalibration (" << size() << " calibrations, "
+	   << mKind.size() << " transformations, " << mCoefficients.size()
+	   << " coefficients)";
+	return os;
+}
+
+boost::shared_ptr<CompactCalibration>
+CompactCalibration::create(Calibration const& calib)
+{
+	return boost::shared_ptr<CompactCalibration>(new CompactCalibration(calib));
+}
+
+std::ostream& operator<< (std::ostream& os, CompactCalibration const& c)
+{
+	return c.operator<<(os);
+}
+
+} // calibtic
@@ -0,0 +1,223 @@
+#include "calibtic/Executor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace calibtic {
+
+namespace {
+
+// chunks per thread for the automatic grain, some slack for uneven chunks
+size_t const chunks_per_thread = 4;
+
+// set while a thread processes a chunk, nested calls run sequentially
+thread_local bool inside_chunk = false;
+
+} // namespace
+
+class Executor::Impl
+{
+public:
+	explicit Impl(size_t threads);
+	~Impl();
+
+	size_t size() const;
+
+	void run(size_t n, range_function const& f, size_t grain);
+
+private:
+	struct Job
+	{
+		range_function const* f;
+		size_t n;
+		size_t grain;
+		size_t chunks;
+		std::atomic<size_t> next;
+		std::atomic<size_t> done;
+		std::vector<std::exception_ptr> errors;
+	};
+
+	void work();
+	void process(Job& job);
+
+	std::vector<std::thread> mThreads;
+
+	/// serializes run
+	std::mutex mRun;
+
+	/// protects the members below
+	std::mutex mMutex;
+	std::condition_variable mWake;
+	std::condition_variable mDone;
+	Job* mJob;
+	uint64_t mGeneration;
+	/// number of workers inside the current job
+	size_t mActive;
+	bool mStop;
+};
+
+Executor::Impl::Impl(size_t threads) :
+	mJob(nullptr),
+	mGeneration(0),
+	mActive(0),
+	mStop(false)
+{
+	if (threads == 0) {
+		threads = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	mThreads.reserve(threads - 1);
+	for (size_t ii = 1; ii < threads; ++ii) {
+		mThreads.emplace_back(&Impl::work, this);
+	}
+}
+
+Executor::Impl::~Impl()
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mStop = true;
+	}
+	mWake.notify_all();
+	for (auto& thread : mThreads) {
+		thread.join();
+	}
+}
+
+size_t Executor::Impl::size() const
+{
+	return mThreads.size() + 1;
+}
+
+void Executor::Impl::work()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	uint64_t seen = mGeneration;
+	for (;;) {
+		mWake.wait(lock, [&] { return mStop || mGeneration != seen; });
+		if (mStop) {
+			return;
+		}
+		seen = mGeneration;
+		if (!mJob) {
+			// woken after the job was finished by others
+			continue;
+		}
+
+		Job& job = *mJob;
+		++mActive;
+		lock.unlock();
+		process(job);
+		lock.lock();
+		if (--mActive == 0) {
+			mDone.notify_all();
+		}
+	}
+}
+
+void Executor::Impl::process(Job& job)
+{
+	for (;;) {
+		size_t const chunk = job.next.fetch_add(1);
+		if (chunk >= job.chunks) {
+			return;
+		}
+
+		size_t const begin = chunk * job.grain;
+		size_t const end = std::min(job.n, begin + job.grain);
+
+		inside_chunk = true;
+		try {
+			(*job.f)(begin, end);
+		} catch (...) {
+			job.errors[chunk] = std::current_exception();
+		}
+		inside_chunk = false;
+
+		job.done.fetch_add(1);
+	}
+}
+
+void Executor::Impl::run(size_t const n, range_function const& f, size_t grain)
+{
+	if (n == 0) {
+		return;
+	}
+
+	if (grain == 0) {
+		size_t const chunks = std::min(n, chunks_per_thread * size());
+		grain = (n + chunks - 1) / chunks;
+	}
+	size_t const chunks = (n + grain - 1) / grain;
+
+	if (chunks == 1 || mThreads.empty() || inside_chunk) {
+		for (size_t begin = 0; begin < n; begin += grain) {
+			f(begin, std::min(n, begin + grain));
+		}
+		return;
+	}
+
+	std::lock_guard<std::mutex> run_lock(mRun);
+
+	Job job;
+	job.f = &f;
+	job.n = n;
+	job.grain = grain;
+	job.chunks = chunks;
+	job.next = 0;
+	job.done = 0;
+	job.errors.resize(chunks);
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mJob = &job;
+		++mGeneration;
+	}
+	mWake.notify_all();
+
+	process(job);
+
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		mDone.wait(lock, [&] { return job.done == job.chunks && mActive == 0; });
+		mJob = nullptr;
+	}
+
+	for (auto const& error : job.errors) {
+		if (error) {
+			std::rethrow_exception(error);
+		}
+	}
+}
+
+Executor::Executor(size_t const threads) :
+	mImpl(new Impl(threads))
+{
+}
+
+Executor::~Executor()
+{
+}
+
+size_t Executor::size() const
+{
+	return mImpl->size();
+}
+
+void Executor::parallel_for(size_t const n, range_function const& f, size_t const grain)
+{
+	mImpl->run(n, f, grain);
+}
+
+boost::shared_ptr<Executor> Executor::create(size_t const threads)
+{
+	return boost::shared_ptr<Executor>(new Executor(threads));
+}
+
+} // calibtic
@@ -1,14 +1,97 @@
 #include "calibtic/backend/Backend.h"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <set>
 #include <sstream>
 #include <stdexcept>
+#include <thread>
 #include <dlfcn.h>
 
 #include "calibtic/backend/Library.h"
 #include "calibtic/backend/BackendDeleter.h"
+#include "calibtic/Base.h"
+#include "calibtic/Calibration.h"
+#include "calibtic/Collection.h"
+#include "calibtic/trafo/Pool.h"
 
 namespace calibtic {
 namespace backend {
 
+/// single worker thread running tasks in the order they were pushed
+class Backend::AsyncQueue
+{
+public:
+	AsyncQueue() :
+		mPushed(0),
+		mFinished(0),
+		mStop(false),
+		mThread(&AsyncQueue::work, this)
+	{}
+
+	/// tasks not started yet are dropped, their futures report a broken
+	/// promise
+	~AsyncQueue()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mStop = true;
+		}
+		mWake.notify_one();
+		mThread.join();
+	}
+
+	void push(std::function<void()> const& task)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mTasks.push_back(task);
+			++mPushed;
+		}
+		mWake.notify_one();
+	}
+
+	/// waits for the tasks pushed before the call only, so that producers
+	/// pushing all the time cannot keep it waiting
+	void wait()
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		size_t const target = mPushed;
+		mDone.wait(lock, [this, target] { return mFinished >= target; });
+	}
+
+private:
+	void work()
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		while (true) {
+			mWake.wait(lock, [this] { return mStop || !mTasks.empty(); });
+			if (mStop) {
+				return;
+			}
+
+			std::function<void()> const task = mTasks.front();
+			mTasks.pop_front();
+			lock.unlock();
+			task();
+			lock.lock();
+			++mFinished;
+			mDone.notify_all();
+		}
+	}
+
+	std::mutex mMutex;
+	std::condition_variable mWake;
+	std::condition_variable mDone;
+	std::deque<std::function<void()> > mTasks;
+	/// number of tasks pushed and finished, tasks run in this order
+	size_t mPushed;
+	size_t mFinished;
+	bool mStop;
+
+	std::thread mThread;
+};
+
 void Backend::config(
 	std::string const& key,
 	std::string const& val)
@@ -48,12 +131,118 @@ void Backend::config_(
 	}
 }
 
+void Backend::load(
+	std::string const& id,
+	MetaData& metadata,
+	Collection& c,
+	std::vector<int> const& keys)
+{
+	load(id, metadata, c);
+
+	std::set<int> const requested(keys.begin(), keys.end());
+	for (auto const key : c.keys()) {
+		if (!requested.count(key)) {
+			c.erase(key);
+		}
+	}
+}
+
+template<typename Return>
+std::future<Return> Backend::enqueue(std::function<Return()> const& f)
+{
+	// std::function needs a copyable target
+	auto const task = std::make_shared<std::packaged_task<Return()> >(f);
+	auto res = task->get_future();
+
+	std::lock_guard<std::mutex> lock(mAsyncMutex);
+	if (!mAsync) {
+		mAsync.reset(new AsyncQueue);
+	}
+	mAsync->push([task] { (*task)(); });
+	return res;
+}
+
+std::future<MetaData> Backend::load_async(
+	std::string const& id,
+	boost::shared_ptr<Collection> c)
+{
+	return enqueue<MetaData>([this, id, c] {
+		MetaData metadata;
+		load(id, metadata, *c);
+		return metadata;
+	});
+}
+
+std::future<MetaData> Backend::load_async(
+	std::string const& id,
+	boost::shared_ptr<Calibration> c)
+{
+	return enqueue<MetaData>([this, id, c] {
+		MetaData metadata;
+		load(id, metadata, *c);
+		return metadata;
+	});
+}
+
+std::future<void> Backend::store_async(
+	std::string const& id,
+	MetaData const& metadata,
+	boost::shared_ptr<Collection const> c)
+{
+	return enqueue<void>([this, id, metadata, c] {
+		store(id, metadata, *c);
+	});
+}
+
+std::future<void> Backend::store_async(
+	std::string const& id,
+	MetaData const& metadata,
+	boost::shared_ptr<Calibration const> c)
+{
+	return enqueue<void>([this, id, metadata, c] {
+		store(id, metadata, *c);
+	});
+}
+
+void Backend::wait()
+{
+	boost::shared_ptr<AsyncQueue> queue;
+	{
+		std::lock_guard<std::mutex> lock(mAsyncMutex);
+		queue = mAsync;
+	}
+	if (queue) {
+		queue->wait();
+	}
+}
+
 bool Backend::exists(std::string const& key) const
 {
 	auto it = mConfig.find(key);
 	return (it != mConfig.end());
 }
 
+void Backend::deduplicate(Base& base)
+{
+	auto const pool = getPool();
+	if (pool) {
+		base.intern(*pool);
+	}
+}
+
+boost::shared_ptr<trafo::Pool> Backend::getPool()
+{
+	if (!exists("deduplicate") || !get<int>("deduplicate")) {
+		return boost::shared_ptr<trafo::Pool>();
+	}
+
+	std::lock_guard<std::mutex> lock(mPoolMutex);
+	if (!mPool) {
+		mPool.reset(new trafo::Pool);
+	}
+	return mPool;
+}
+
 
 boost::shared_ptr<Backend>
 loadBackend(boost::shared_ptr<Library> lib)
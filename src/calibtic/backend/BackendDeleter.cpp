@@ -13,6 +13,8 @@ BackendDeleter::BackendDeleter(boost::shared_ptr<Library> lib) :
 
 void BackendDeleter::operator () (Backend* b) const
 {
+	// pending asynchronous operations still use the derived object
+	b->wait();
 	destroy_backend(lib->get(), b);
 }
 
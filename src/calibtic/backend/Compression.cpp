@@ -0,0 +1,126 @@
+#include "calibtic/backend/Compression.h"
+
+#include <fstream>
+#include <stdexcept>
+
+#include <boost/iostreams/device/file.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#ifdef CALIBTIC_HAVE_ZSTD
+#include <boost/iostreams/filter/zstd.hpp>
+#endif
+#include <boost/iostreams/filtering_stream.hpp>
+
+namespace calibtic {
+namespace backend {
+
+namespace {
+
+unsigned char const gzip_magic[] = {0x1f, 0x8b};
+unsigned char const zstd_magic[] = {0x28, 0xb5, 0x2f, 0xfd};
+
+template<size_t N>
+bool starts_with(char const* data, size_t const size, unsigned char const (&magic)[N])
+{
+	if (size < N) {
+		return false;
+	}
+	for (size_t ii = 0; ii < N; ++ii) {
+		if (static_cast<unsigned char>(data[ii]) != magic[ii]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+Compression detect(std::string const& file)
+{
+	std::ifstream stream(file, std::ios::in | std::ios::binary);
+	if (!stream) {
+		throw std::runtime_error("cannot open " + file);
+	}
+
+	char header[4];
+	stream.read(header, sizeof(header));
+	size_t const size = stream.gcount();
+
+	if (starts_with(header, size, zstd_magic)) {
+		return Compression::zstd;
+	}
+	if (starts_with(header, size, gzip_magic)) {
+		return Compression::gzip;
+	}
+	return Compression::none;
+}
+
+} // namespace
+
+Compression compression(std::string const& name)
+{
+	if (name == "none") {
+		return Compression::none;
+	}
+	if (name == "gzip") {
+		return Compression::gzip;
+	}
+	if (name == "zstd") {
+#ifdef CALIBTIC_HAVE_ZSTD
+		return Compression::zstd;
+#else
+		throw std::runtime_error("unsupported compression: zstd, Boost.Iostreams lacks zstd");
+#endif
+	}
+	throw std::runtime_error("unknown compression: " + name);
+}
+
+boost::shared_ptr<std::istream> openInput(std::string const& file)
+{
+	namespace io = boost::iostreams;
+
+	Compression const format = detect(file);
+	if (format == Compression::none) {
+		return boost::shared_ptr<std::istream>(
+			new std::ifstream(file, std::ios::in | std::ios::binary));
+	}
+
+	boost::shared_ptr<io::filtering_istream> stream(new io::filtering_istream);
+	if (format == Compression::zstd) {
+#ifdef CALIBTIC_HAVE_ZSTD
+		stream->push(io::zstd_decompressor());
+#else
+		throw std::runtime_error("cannot read zstd compressed " + file +
+		                         ", Boost.Iostreams lacks zstd");
+#endif
+	} else {
+		stream->push(io::gzip_decompressor());
+	}
+	stream->push(io::file_source(file, std::ios::in | std::ios::binary));
+	return stream;
+}
+
+boost::shared_ptr<std::ostream> openOutput(std::string const& file,
+                                           Compression const compression)
+{
+	namespace io = boost::iostreams;
+
+	if (compression == Compression::none) {
+		return boost::shared_ptr<std::ostream>(
+			new std::ofstream(file, std::ios::out | std::ios::binary));
+	}
+
+	boost::shared_ptr<io::filtering_ostream> stream(new io::filtering_ostream);
+	if (compression == Compression::zstd) {
+#ifdef CALIBTIC_HAVE_ZSTD
+		stream->push(io::zstd_compressor());
+#else
+		throw std::runtime_error("cannot write zstd compressed " + file +
+		                         ", Boost.Iostreams lacks zstd");
+#endif
+	} else {
+		stream->push(io::gzip_compressor());
+	}
+	stream->push(io::file_sink(file, std::ios::out | std::ios::binary));
+	return stream;
+}
+
+} // backend
+} // calibtic
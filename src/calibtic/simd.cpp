@@ -0,0 +1,30 @@
+#include "calibtic/simd.h"
+
+namespace calibtic {
+namespace simd {
+
+bool supported(Kernel kernel)
+{
+	switch (kernel) {
+		case SCALAR:
+			return true;
+#if defined(__x86_64__) || defined(__i386__)
+		case AVX2:
+			return __builtin_cpu_supports("avx2");
+		case AVX512:
+			return __builtin_cpu_supports("avx512f");
+#endif
+		default:
+			return false;
+	}
+}
+
+Kernel best()
+{
+	static Kernel const kernel =
+	    supported(AVX512) ? AVX512 : (supported(AVX2) ? AVX2 : SCALAR);
+	return kernel;
+}
+
+} // simd
+} // calibtic
@@ -1,5 +1,8 @@
 #include "calibtic/trafo/Constant.h"
 
+#include <algorithm>
+#include <boost/functional/hash.hpp>
+
 namespace calibtic {
 namespace trafo {
 
@@ -20,6 +23,18 @@ Constant::reverseApply(float_type const& /*in*/, Transformation::OutsideDomainBe
 	throw std::runtime_error("Constants cannot be reversed.");
 }
 
+void
+Constant::apply(float_type const* /*in*/, float_type* out, size_t n, OutsideDomainBehavior /*outside_domain_behavior*/) const
+{
+	std::fill(out, out + n, mData);
+}
+
+void
+Constant::reverseApply(float_type const* /*in*/, float_type* /*out*/, size_t /*n*/, Transformation::OutsideDomainBehavior /*outside_domain_behavior*/) const
+{
+	throw std::runtime_error("Constants cannot be reversed.");
+}
+
 bool
 Constant::operator== (Transformation const& rhs) const
 {
@@ -31,6 +46,14 @@ Constant::operator== (Transformation const& rhs) const
 	return (mData == _rhs->mData);
 }
 
+size_t
+Constant::hash() const
+{
+	size_t seed = Transformation::hash();
+	boost::hash_combine(seed, mData);
+	return seed;
+}
+
 std::ostream&
 Constant::operator<< (std::ostream& os) const
 {
@@ -0,0 +1,179 @@
+#include "calibtic/trafo/Horner.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CALIBTIC_HORNER_X86
+#endif
+
+// Multiplication and addition must not be fused, otherwise the result would
+// depend on the kernel (and on the compiler flags) that happened to be used.
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+namespace calibtic {
+namespace trafo {
+namespace horner {
+
+namespace {
+
+template <bool NegativePowers>
+inline float_type evaluate_scalar(float_type const* coeff, size_t ncoeff, float_type x)
+{
+	if (ncoeff == 0) {
+		return 0.;
+	}
+
+	if (NegativePowers) {
+		x = 1. / x;
+	}
+
+	float_type r = coeff[ncoeff - 1];
+	for (size_t ii = ncoeff - 1; ii-- > 0;) {
+		r = r * x + coeff[ii];
+	}
+	return r;
+}
+
+template <bool NegativePowers>
+void evaluate_scalar(float_type const* coeff, size_t ncoeff,
+                     float_type const* in, float_type* out, size_t n)
+{
+	for (size_t ii = 0; ii < n; ++ii) {
+		out[ii] = evaluate_scalar<NegativePowers>(coeff, ncoeff, in[ii]);
+	}
+}
+
+#ifdef CALIBTIC_HORNER_X86
+
+// Two independent vectors are evaluated per iteration to hide the latency of
+// the dependent multiply-add chain, the remainder is done by the scalar loop.
+
+template <bool NegativePowers>
+__attribute__((target("avx2")))
+void evaluate_avx2(float_type const* coeff, size_t ncoeff,
+                   float_type const* in, float_type* out, size_t n)
+{
+	__m256d const one = _mm256_set1_pd(1.);
+	__m256d const last = _mm256_set1_pd(coeff[ncoeff - 1]);
+
+	size_t ii = 0;
+	for (; ii + 8 <= n; ii += 8) {
+		__m256d x0 = _mm256_loadu_pd(in + ii);
+		__m256d x1 = _mm256_loadu_pd(in + ii + 4);
+		if (NegativePowers) {
+			x0 = _mm256_div_pd(one, x0);
+			x1 = _mm256_div_pd(one, x1);
+		}
+
+		__m256d r0 = last;
+		__m256d r1 = last;
+		for (size_t kk = ncoeff - 1; kk-- > 0;) {
+			__m256d const c = _mm256_set1_pd(coeff[kk]);
+			r0 = _mm256_add_pd(_mm256_mul_pd(r0, x0), c);
+			r1 = _mm256_add_pd(_mm256_mul_pd(r1, x1), c);
+		}
+
+		_mm256_storeu_pd(out + ii, r0);
+		_mm256_storeu_pd(out + ii + 4, r1);
+	}
+
+	evaluate_scalar<NegativePowers>(coeff, ncoeff, in + ii, out + ii, n - ii);
+}
+
+template <bool NegativePowers>
+__attribute__((target("avx512f")))
+void evaluate_avx512(float_type const* coeff, size_t ncoeff,
+                     float_type const* in, float_type* out, size_t n)
+{
+	__m512d const one = _mm512_set1_pd(1.);
+	__m512d const last = _mm512_set1_pd(coeff[ncoeff - 1]);
+
+	size_t ii = 0;
+	for (; ii + 16 <= n; ii += 16) {
+		__m512d x0 = _mm512_loadu_pd(in + ii);
+		__m512d x1 = _mm512_loadu_pd(in + ii + 8);
+		if (NegativePowers) {
+			x0 = _mm512_div_pd(one, x0);
+			x1 = _mm512_div_pd(one, x1);
+		}
+
+		__m512d r0 = last;
+		__m512d r1 = last;
+		for (size_t kk = ncoeff - 1; kk-- > 0;) {
+			__m512d const c = _mm512_set1_pd(coeff[kk]);
+			r0 = _mm512_add_pd(_mm512_mul_pd(r0, x0), c);
+			r1 = _mm512_add_pd(_mm512_mul_pd(r1, x1), c);
+		}
+
+		_mm512_storeu_pd(out + ii, r0);
+		_mm512_storeu_pd(out + ii + 8, r1);
+	}
+
+	evaluate_scalar<NegativePowers>(coeff, ncoeff, in + ii, out + ii, n - ii);
+}
+
+#endif // CALIBTIC_HORNER_X86
+
+template <bool NegativePowers>
+void evaluate_batch(float_type const* coeff, size_t ncoeff,
+                    float_type const* in, float_type* out, size_t n,
+                    simd::Kernel kernel)
+{
+	if (!simd::supported(kernel)) {
+		throw std::runtime_error("horner: requested kernel not supported by this cpu");
+	}
+
+	if (ncoeff == 0) {
+		std::fill(out, out + n, 0.);
+		return;
+	}
+
+	switch (kernel) {
+#ifdef CALIBTIC_HORNER_X86
+		case simd::AVX512:
+			evaluate_avx512<NegativePowers>(coeff, ncoeff, in, out, n);
+			break;
+		case simd::AVX2:
+			evaluate_avx2<NegativePowers>(coeff, ncoeff, in, out, n);
+			break;
+#endif // CALIBTIC_HORNER_X86
+		default:
+			evaluate_scalar<NegativePowers>(coeff, ncoeff, in, out, n);
+	}
+}
+
+} // namespace
+
+float_type evaluate(float_type const* coeff, size_t ncoeff, float_type x)
+{
+	return evaluate_scalar<false>(coeff, ncoeff, x);
+}
+
+float_type evaluate_negative_powers(float_type const* coeff, size_t ncoeff, float_type x)
+{
+	return evaluate_scalar<true>(coeff, ncoeff, x);
+}
+
+void evaluate(float_type const* coeff, size_t ncoeff,
+              float_type const* in, float_type* out, size_t n,
+              simd::Kernel kernel)
+{
+	evaluate_batch<false>(coeff, ncoeff, in, out, n, kernel);
+}
+
+void evaluate_negative_powers(float_type const* coeff, size_t ncoeff,
+                              float_type const* in, float_type* out, size_t n,
+                              simd::Kernel kernel)
+{
+	evaluate_batch<true>(coeff, ncoeff, in, out, n, kernel);
+}
+
+} // horner
+} // trafo
+} // calibtic
@@ -2,6 +2,7 @@
 
 #include <cmath>
 #include <iostream>
+#include <boost/functional/hash.hpp>
 
 namespace calibtic {
 namespace trafo {
@@ -29,21 +30,45 @@ float_type InvQuadraticPol::apply(float_type const& in, OutsideDomainBehavior ou
 
 	const float_type val = respectDomain(in, outside_domain_behavior);
 
-	double const r = pow(mData[0], 2) + mData[1]*(mData[2] + val);
+	return evaluate(val);
+}
 
-	if(r < 0) {
-		throw std::runtime_error("imaginary result");
+float_type
+InvQuadraticPol::reverseApply(float_type const& /*in*/, Transformation::OutsideDomainBehavior /*outside_domain_behavior*/) const
+{
+	throw std::runtime_error("Not implemented");
+}
+
+void InvQuadraticPol::apply(float_type const* in, float_type* out, size_t n, OutsideDomainBehavior outside_domain_behavior) const
+{
+    if (mData.size() < 4) {
+		throw std::runtime_error("invalid data set");
 	}
 
-	return (mData[0] + mSignum*sqrt(r)) / mData[3];
+	respectDomain(in, out, n, outside_domain_behavior);
+
+	for (size_t ii = 0; ii < n; ++ii) {
+		out[ii] = evaluate(out[ii]);
+	}
 }
 
-float_type
-InvQuadraticPol::reverseApply(float_type const& /*in*/, Transformation::OutsideDomainBehavior /*outside_domain_behavior*/) const
+void
+InvQuadraticPol::reverseApply(float_type const* /*in*/, float_type* /*out*/, size_t /*n*/, Transformation::OutsideDomainBehavior /*outside_domain_behavior*/) const
 {
 	throw std::runtime_error("Not implemented");
 }
 
+float_type InvQuadraticPol::evaluate(float_type const val) const
+{
+	double const r = pow(mData[0], 2) + mData[1]*(mData[2] + val);
+
+	if(r < 0) {
+		throw std::runtime_error("imaginary result");
+	}
+
+	return (mData[0] + mSignum*sqrt(r)) / mData[3];
+}
+
 bool InvQuadraticPol::operator== (Transformation const& rhs) const
 {
 	InvQuadraticPol const* _rhs = dynamic_cast<InvQuadraticPol const*>(&rhs);
@@ -53,6 +78,13 @@ bool InvQuadraticPol::operator== (Transformation const& rhs) const
 	return (mData == _rhs->mData) && (mDomain == _rhs->mDomain);
 }
 
+size_t InvQuadraticPol::hash() const
+{
+	size_t seed = Transformation::hash();
+	boost::hash_range(seed, mData.begin(), mData.end());
+	return seed;
+}
+
 std::ostream& InvQuadraticPol::operator<< (std::ostream& os) const
 {
 	os << "InvQuadraticPol: ";
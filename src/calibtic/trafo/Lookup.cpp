@@ -4,27 +4,41 @@
 
 #include <log4cxx/logger.h>
 #include <algorithm>
+#include <cmath>
+#include <functional>
+#include <boost/functional/hash.hpp>
 
 static log4cxx::LoggerPtr _log = log4cxx::Logger::getLogger("Calibtic");
 
 namespace calibtic {
 namespace trafo {
 
+namespace {
+
+// below this size the binary search fits into a few cache lines anyway
+size_t const min_size_accelerated_search = 64;
+
+// the first guess of the interpolation search has to be this close (in
+// entries) to the result
+float_type const max_interpolation_error = 4.;
+
+typedef std::less<Lookup::data_type::value_type> raising_compare;
+typedef std::greater_equal<Lookup::data_type::value_type> falling_compare;
+
+} // namespace
+
 Lookup::Lookup(data_type const& data, size_t offset) :
 	mData(data),
 	mOffset(offset),
 	mSearchMode(determineSearchMode(data))
 {
+	buildEytzinger();
+
 	if(mData.size()) {
-		switch(mSearchMode) {
-			case SEARCH_BINARY_RAISING:
-				setDomain(mData.front(), mData.back());
-				break;
-			case SEARCH_BINARY_FALLING:
-				setDomain(mData.back(), mData.front());
-				break;
-			default:
-				throw std::runtime_error("calibtic::Lookup: Unreachable!");
+		if (raising()) {
+			setDomain(mData.front(), mData.back());
+		} else {
+			setDomain(mData.back(), mData.front());
 		}
 	}
 }
@@ -36,20 +50,31 @@ Lookup::apply(float_type const& in, OutsideDomainBehavior outside_domain_behavio
 {
 	float_type val = respectDomain(in, outside_domain_behavior);
 
-	data_type::const_iterator pos = mData.end();
+	size_t pos = mData.size();
 	switch(mSearchMode) {
 		case SEARCH_BINARY_RAISING:
-			pos = std::lower_bound(mData.begin(), mData.end(), val);
+			pos = lowerBoundBinary(val, raising_compare());
 			break;
 		case SEARCH_BINARY_FALLING:
-			pos = std::lower_bound(mData.begin(), mData.end(), val,
-				                   std::greater_equal<data_type::value_type>());
+			pos = lowerBoundBinary(val, falling_compare());
+			break;
+		case SEARCH_EYTZINGER_RAISING:
+			pos = lowerBoundEytzinger(val, raising_compare());
+			break;
+		case SEARCH_EYTZINGER_FALLING:
+			pos = lowerBoundEytzinger(val, falling_compare());
+			break;
+		case SEARCH_INTERPOLATION_RAISING:
+			pos = lowerBoundInterpolation(val, raising_compare());
+			break;
+		case SEARCH_INTERPOLATION_FALLING:
+			pos = lowerBoundInterpolation(val, falling_compare());
 			break;
 		default:
 			throw std::runtime_error("calibtic::Lookup: Unreachable!");
 	}
 
-	return std::distance(mData.begin(), pos) + mOffset - 1;
+	return pos + mOffset - 1;
 }
 
 float_type
@@ -59,12 +84,80 @@ Lookup::reverseApply(float_type const& in, Transformation::OutsideDomainBehavior
 	return mData.at(idx);
 }
 
+void
+Lookup::apply(float_type const* in, float_type* out, size_t n, OutsideDomainBehavior outside_domain_behavior) const
+{
+	respectDomain(in, out, n, outside_domain_behavior);
+
+	switch(mSearchMode) {
+		case SEARCH_BINARY_RAISING:
+			lookupAll(out, n, [this](float_type val) {
+				return lowerBoundBinary(val, raising_compare());
+			});
+			break;
+		case SEARCH_BINARY_FALLING:
+			lookupAll(out, n, [this](float_type val) {
+				return lowerBoundBinary(val, falling_compare());
+			});
+			break;
+		case SEARCH_EYTZINGER_RAISING:
+			lookupAll(out, n, [this](float_type val) {
+				return lowerBoundEytzinger(val, raising_compare());
+			});
+			break;
+		case SEARCH_EYTZINGER_FALLING:
+			lookupAll(out, n, [this](float_type val) {
+				return lowerBoundEytzinger(val, falling_compare());
+			});
+			break;
+		case SEARCH_INTERPOLATION_RAISING:
+			lookupAll(out, n, [this](float_type val) {
+				return lowerBoundInterpolation(val, raising_compare());
+			});
+			break;
+		case SEARCH_INTERPOLATION_FALLING:
+			lookupAll(out, n, [this](float_type val) {
+				return lowerBoundInterpolation(val, falling_compare());
+			});
+			break;
+		default:
+			throw std::runtime_error("calibtic::Lookup: Unreachable!");
+	}
+}
+
+void
+Lookup::reverseApply(float_type const* in, float_type* out, size_t n, Transformation::OutsideDomainBehavior outside_domain_behavior) const
+{
+	respectReverseDomain(in, out, n, outside_domain_behavior);
+
+	for (size_t ii = 0; ii < n; ++ii) {
+		const int idx = out[ii] - mOffset;
+		out[ii] = mData.at(idx);
+	}
+}
+
 Lookup::data_type const&
 Lookup::getData() const
 {
 	return mData;
 }
 
+Lookup::search_mode
+Lookup::getSearchMode() const
+{
+	return mSearchMode;
+}
+
+void
+Lookup::setSearchMode(search_mode mode)
+{
+	if (binarySearchMode(mode) != binarySearchMode(mSearchMode)) {
+		throw std::runtime_error(
+		    "calibtic::Lookup: search mode does not match the order of the data");
+	}
+	mSearchMode = mode;
+}
+
 bool
 Lookup::operator== (Transformation const& rhs) const
 {
@@ -77,6 +170,15 @@ Lookup::operator== (Transformation const& rhs) const
 	       (mDomain == _rhs->mDomain);
 }
 
+size_t
+Lookup::hash() const
+{
+	size_t seed = Transformation::hash();
+	boost::hash_combine(seed, mOffset);
+	boost::hash_range(seed, mData.begin(), mData.end());
+	return seed;
+}
+
 std::ostream&
 Lookup::operator<< (std::ostream& os) const
 {
@@ -90,11 +192,152 @@ Lookup::operator<< (std::ostream& os) const
 
 Lookup::search_mode Lookup::determineSearchMode(const data_type & data)
 {
+	search_mode direction;
 	if (std::is_sorted(data.begin(), data.end()))
-		return SEARCH_BINARY_RAISING;
-	if (std::is_sorted(data.rbegin(), data.rend()))
-		return SEARCH_BINARY_FALLING;
-	throw std::runtime_error("calibtic::Lookup: Provided data is not sorted!");
+		direction = SEARCH_BINARY_RAISING;
+	else if (std::is_sorted(data.rbegin(), data.rend()))
+		direction = SEARCH_BINARY_FALLING;
+	else
+		throw std::runtime_error("calibtic::Lookup: Provided data is not sorted!");
+
+	size_t const n = data.size();
+	if (n < min_size_accelerated_search) {
+		return direction;
+	}
+
+	// interpolation only pays off if the data is close to linear
+	float_type const step = (data.back() - data.front()) / (n - 1);
+	bool near_linear = step != 0.;
+	for (size_t ii = 0; near_linear && ii < n; ++ii) {
+		float_type const error = (data[ii] - (data.front() + step * ii)) / step;
+		near_linear = std::abs(error) <= max_interpolation_error;
+	}
+
+	if (direction == SEARCH_BINARY_RAISING) {
+		return near_linear ? SEARCH_INTERPOLATION_RAISING : SEARCH_EYTZINGER_RAISING;
+	}
+	return near_linear ? SEARCH_INTERPOLATION_FALLING : SEARCH_EYTZINGER_FALLING;
+}
+
+Lookup::search_mode Lookup::binarySearchMode(search_mode mode)
+{
+	switch(mode) {
+		case SEARCH_BINARY_RAISING:
+		case SEARCH_EYTZINGER_RAISING:
+		case SEARCH_INTERPOLATION_RAISING:
+			return SEARCH_BINARY_RAISING;
+		case SEARCH_BINARY_FALLING:
+		case SEARCH_EYTZINGER_FALLING:
+		case SEARCH_INTERPOLATION_FALLING:
+			return SEARCH_BINARY_FALLING;
+		default:
+			throw std::runtime_error("calibtic::Lookup: Unreachable!");
+	}
+}
+
+bool Lookup::raising() const
+{
+	return binarySearchMode(mSearchMode) == SEARCH_BINARY_RAISING;
+}
+
+void Lookup::buildEytzinger()
+{
+	size_t const n = mData.size();
+	mEytzinger.assign(n + 1, 0.);
+	mEytzingerIndex.assign(n + 1, n);
+
+	// in-order traversal of the implicit tree assigns the sorted data
+	size_t next = 0;
+	std::function<void(size_t)> fill = [&](size_t k) {
+		if (k <= n) {
+			fill(2 * k);
+			mEytzinger[k] = mData[next];
+			mEytzingerIndex[k] = next++;
+			fill(2 * k + 1);
+		}
+	};
+	fill(1);
+}
+
+template <typename Compare>
+size_t Lookup::lowerBoundBinary(float_type val, Compare comp) const
+{
+	return std::distance(
+	    mData.begin(), std::lower_bound(mData.begin(), mData.end(), val, comp));
+}
+
+template <typename Compare>
+size_t Lookup::lowerBoundEytzinger(float_type val, Compare comp) const
+{
+	size_t const n = mData.size();
+	float_type const* const tree = mEytzinger.data();
+
+	size_t k = 1;
+	while (k <= n) {
+		// the grandchildren of k are adjacent, fetch them early
+		__builtin_prefetch(tree + 4 * k);
+		k = 2 * k + comp(tree[k], val);
+	}
+	// strip the trailing right turns (and the last left turn)
+	k >>= __builtin_ffsll(~k);
+
+	return mEytzingerIndex[k];
+}
+
+template <typename Compare>
+size_t Lookup::lowerBoundInterpolation(float_type val, Compare comp) const
+{
+	size_t const n = mData.size();
+	if (n == 0) {
+		return 0;
+	}
+
+	float_type const* const data = mData.data();
+
+	float_type const guess =
+	    (val - data[0]) / (data[n - 1] - data[0]) * static_cast<float_type>(n - 1);
+	// also catches NaN from constant data or IGNOREd infinite values
+	size_t g = 0;
+	if (guess >= static_cast<float_type>(n - 1)) {
+		g = n - 1;
+	} else if (guess > 0.) {
+		g = static_cast<size_t>(guess);
+	}
+
+	size_t lo, hi;
+	size_t step = 1;
+	if (comp(data[g], val)) {
+		// result is after g, search forward until an entry is not before val
+		lo = g + 1;
+		hi = lo;
+		while (hi < n && comp(data[hi], val)) {
+			lo = hi + 1;
+			hi = lo + step;
+			step *= 2;
+		}
+		hi = std::min(hi, n);
+	} else {
+		// result is g or before, search backward until an entry is before val
+		hi = g;
+		for (;;) {
+			lo = (hi >= step) ? hi - step : 0;
+			if (lo == 0 || comp(data[lo], val)) {
+				break;
+			}
+			hi = lo;
+			step *= 2;
+		}
+	}
+
+	return std::distance(data, std::lower_bound(data + lo, data + hi, val, comp));
+}
+
+template <typename Search>
+void Lookup::lookupAll(float_type* values, size_t n, Search const& search) const
+{
+	for (size_t ii = 0; ii < n; ++ii) {
+		values[ii] = search(values[ii]) + mOffset - 1;
+	}
 }
 
 boost::shared_ptr<Lookup>
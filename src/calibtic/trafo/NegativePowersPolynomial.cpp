@@ -1,5 +1,7 @@
 #include "calibtic/trafo/NegativePowersPolynomial.h"
+#include "calibtic/trafo/Horner.h"
 #include <boost/icl/interval_bounds.hpp>
+#include <algorithm>
 #include <cmath>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_poly.h>
@@ -20,19 +22,12 @@ float_type
 NegativePowersPolynomial::apply(float_type const& in, OutsideDomainBehavior outside_domain_behavior) const
 {
 
-	if (in == 0 && mData.size() > 1) { // only check if polynomial is not a constant
-		throw std::runtime_error("Division by zero.");
-	}
+	checkInput(&in, 1);
 
 	float_type val = respectDomain(in, outside_domain_behavior);
 
-	float_type r = 0.;
-	unsigned exp = 0;
-	for (float_type const& d: Polynomial::getData())
-	{
-		r += d * 1/pow(val, exp++);
-	}
-	return r;
+	data_type const& data = Polynomial::getData();
+	return horner::evaluate_negative_powers(data.data(), data.size(), val);
 }
 
 float_type
@@ -42,6 +37,31 @@ NegativePowersPolynomial::reverseApply(float_type const& in, Transformation::Out
 	return result;
 }
 
+void
+NegativePowersPolynomial::apply(float_type const* in, float_type* out, size_t n, OutsideDomainBehavior outside_domain_behavior) const
+{
+	checkInput(in, n);
+
+	respectDomain(in, out, n, outside_domain_behavior);
+
+	data_type const& data = Polynomial::getData();
+	horner::evaluate_negative_powers(data.data(), data.size(), out, out, n);
+}
+
+void
+NegativePowersPolynomial::checkInput(float_type const* in, size_t n) const
+{
+	if (mData.size() > 1 && std::find(in, in + n, 0.) != in + n) { // only check if polynomial is not a constant
+		throw std::runtime_error("Division by zero.");
+	}
+}
+
+void
+NegativePowersPolynomial::reverseApply(float_type const* in, float_type* out, size_t n, Transformation::OutsideDomainBehavior outside_domain_behavior) const
+{
+	Polynomial::reverseApply(in, out, n, outside_domain_behavior);
+}
+
 bool
 NegativePowersPolynomial::operator== (Transformation const& rhs) const
 {
@@ -89,6 +109,28 @@ NegativePowersPolynomial::find_real_roots(float_type const val, bool in_domain)
 	return result;
 }
 
+bool
+NegativePowersPolynomial::solver_interval(float_type& lower, float_type& upper) const
+{
+	float_type const min = getDomain().lower();
+	float_type const max = getDomain().upper();
+
+	// t = 1/x is only continuous if the domain does not contain 0
+	if (!(min > 0. || max < 0.)) {
+		return false;
+	}
+
+	lower = 1/max;
+	upper = 1/min;
+	return std::isfinite(lower) && std::isfinite(upper);
+}
+
+float_type
+NegativePowersPolynomial::from_solver_variable(float_type const t) const
+{
+	return 1/t;
+}
+
 boost::shared_ptr<NegativePowersPolynomial>
 NegativePowersPolynomial::create(data_type const& coeff,
 		float_type const& min, float_type const& max)
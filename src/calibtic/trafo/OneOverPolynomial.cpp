@@ -1,5 +1,7 @@
 #include "calibtic/trafo/OneOverPolynomial.h"
 #include <boost/icl/interval_bounds.hpp>
+#include <boost/functional/hash.hpp>
+#include <algorithm>
 #include <cmath>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_poly.h>
@@ -39,6 +41,34 @@ OneOverPolynomial::reverseApply(float_type const& in, Transformation::OutsideDom
 	return mPolynomial.reverseApply(1/val, outside_domain_behavior);
 }
 
+void
+OneOverPolynomial::apply(float_type const* in, float_type* out, size_t n, OutsideDomainBehavior outside_domain_behavior) const
+{
+	respectDomain(in, out, n, outside_domain_behavior);
+
+	mPolynomial.apply(out, out, n, outside_domain_behavior);
+
+	for (size_t ii = 0; ii < n; ++ii) {
+		out[ii] = 1/out[ii];
+	}
+}
+
+void
+OneOverPolynomial::reverseApply(float_type const* in, float_type* out, size_t n, Transformation::OutsideDomainBehavior outside_domain_behavior) const
+{
+	if (std::find(in, in + n, 0.) != in + n) {
+		throw std::runtime_error("reverseApply(0) not possible.");
+	}
+
+	respectReverseDomain(in, out, n, outside_domain_behavior);
+
+	for (size_t ii = 0; ii < n; ++ii) {
+		out[ii] = 1/out[ii];
+	}
+
+	mPolynomial.reverseApply(out, out, n, outside_domain_behavior);
+}
+
 OneOverPolynomial::data_type const&
 OneOverPolynomial::getData() const
 {
@@ -51,6 +81,30 @@ OneOverPolynomial::getData()
 	return mPolynomial.getData();
 }
 
+void
+OneOverPolynomial::setUseInverseCache(bool enable)
+{
+	mPolynomial.setUseInverseCache(enable);
+}
+
+bool
+OneOverPolynomial::getUseInverseCache() const
+{
+	return mPolynomial.getUseInverseCache();
+}
+
+void
+OneOverPolynomial::setRootFinder(Polynomial::RootFinder root_finder)
+{
+	mPolynomial.setRootFinder(root_finder);
+}
+
+Polynomial::RootFinder
+OneOverPolynomial::getRootFinder() const
+{
+	return mPolynomial.getRootFinder();
+}
+
 bool
 OneOverPolynomial::operator== (Transformation const& rhs) const
 {
@@ -63,6 +117,14 @@ OneOverPolynomial::operator== (Transformation const& rhs) const
 		    && mPolynomial == _rhs->mPolynomial);
 }
 
+size_t
+OneOverPolynomial::hash() const
+{
+	size_t seed = Transformation::hash();
+	boost::hash_combine(seed, mPolynomial.hash());
+	return seed;
+}
+
 std::ostream&
 OneOverPolynomial::operator<< (std::ostream& os) const
 {
@@ -1,6 +1,12 @@
 #include "calibtic/trafo/Polynomial.h"
+#include "calibtic/trafo/Horner.h"
 #include <boost/icl/interval_bounds.hpp>
+#include <boost/functional/hash.hpp>
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
+#include <limits>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_poly.h>
 
@@ -11,10 +17,338 @@ static log4cxx::LoggerPtr _log = log4cxx::Logger::getLogger("Calibtic");
 namespace calibtic {
 namespace trafo {
 
+namespace {
+
+// all complex roots of sum_i coeff[i] * x^i = 0, see Polynomial::find_roots
+std::vector<std::complex<float_type>>
+complex_roots(Polynomial::data_type const& coeff)
+{
+	const size_t dim = coeff.size();
+
+	std::vector<std::complex<float_type>> result;
+
+	if (dim < 1) {
+		return result;
+	}
+
+	Polynomial::data_type data(coeff);
+
+	Polynomial::data_type tmp((dim - 1) * 2);
+	std::unique_ptr<gsl_poly_complex_workspace,
+		void (*)(gsl_poly_complex_workspace*)> w(
+			gsl_poly_complex_workspace_alloc(dim),
+			&gsl_poly_complex_workspace_free);
+	if (gsl_poly_complex_solve(data.data(), dim, w.get(), tmp.data())
+		!= GSL_SUCCESS)
+	{
+		throw std::runtime_error("Search for roots didn't converge");
+	}
+
+	// The results may be complex and are stored in an array
+	// { x0, x0' * i, x1, x1' * i, ... }
+	// First we check for complex solutions and throw in this case, then
+	// we pick only the real solutions
+	for (size_t ii = 0; ii < tmp.size(); ii += 2)
+	{
+		result.emplace_back(tmp[ii], tmp[ii+1]);
+	}
+	return result;
+}
+
+// Brent's method for sum_i coeff[i] * t^i = val in [lower, upper], see
+// R. P. Brent, Algorithms for Minimization without Derivatives, ch. 4
+float_type brent(Polynomial::data_type const& coeff, float_type const val,
+                 float_type const lower, float_type const upper)
+{
+	static size_t const max_iterations = 200;
+
+	auto f = [&coeff, val](float_type t) {
+		return horner::evaluate(coeff.data(), coeff.size(), t) - val;
+	};
+
+	float_type a = lower;
+	float_type b = upper;
+	float_type fa = f(a);
+	float_type fb = f(b);
+
+	if (fa == 0.) {
+		return a;
+	}
+	if (fb == 0.) {
+		return b;
+	}
+	if ((fa > 0.) == (fb > 0.) || std::isnan(fa) || std::isnan(fb)) {
+		throw OutsideDomainException("No solutions or more than one solution in domain found.");
+	}
+
+	float_type c = a;
+	float_type fc = fa;
+	float_type d = b - a;
+	float_type e = d;
+
+	for (size_t iteration = 0; iteration < max_iterations; ++iteration) {
+		if ((fb > 0.) == (fc > 0.)) {
+			c = a;
+			fc = fa;
+			d = b - a;
+			e = d;
+		}
+		if (std::abs(fc) < std::abs(fb)) {
+			a = b;
+			b = c;
+			c = a;
+			fa = fb;
+			fb = fc;
+			fc = fa;
+		}
+
+		float_type const tol =
+		    2. * std::numeric_limits<float_type>::epsilon() * std::abs(b) +
+		    std::numeric_limits<float_type>::min();
+		float_type const m = (c - b) / 2.;
+		if (std::abs(m) <= tol || fb == 0.) {
+			return b;
+		}
+
+		if (std::abs(e) >= tol && std::abs(fa) > std::abs(fb)) {
+			// interpolation
+			float_type p, q;
+			float_type const s = fb / fa;
+			if (a == c) {
+				// secant
+				p = 2. * m * s;
+				q = 1. - s;
+			} else {
+				// inverse quadratic
+				float_type const qq = fa / fc;
+				float_type const r = fb / fc;
+				p = s * (2. * m * qq * (qq - r) - (b - a) * (r - 1.));
+				q = (qq - 1.) * (r - 1.) * (s - 1.);
+			}
+			if (p > 0.) {
+				q = -q;
+			} else {
+				p = -p;
+			}
+
+			if (2. * p < std::min(3. * m * q - std::abs(tol * q), std::abs(e * q))) {
+				e = d;
+				d = p / q;
+			} else {
+				d = m;
+				e = m;
+			}
+		} else {
+			// bisection
+			d = m;
+			e = m;
+		}
+
+		a = b;
+		fa = fb;
+		if (std::abs(d) > tol) {
+			b += d;
+		} else {
+			b += (m > 0.) ? tol : -tol;
+		}
+		fb = f(b);
+	}
+	throw std::runtime_error("Search for roots didn't converge");
+}
+
+} // namespace
+
+/// Inverse of a polynomial that is strictly monotone on [lower, upper].
+///
+/// The polynomial is sampled on a uniform grid, a second uniform grid over
+/// the function values points to the segment containing a value. The linear
+/// interpolation within that segment is refined by safeguarded Newton steps.
+/// Solving needs a constant number of operations and no allocation.
+class Polynomial::InverseCache
+{
+public:
+	InverseCache(data_type const& coeff, float_type lower, float_type upper);
+
+	bool matches(data_type const& coeff, float_type lower, float_type upper) const;
+
+	// false if the polynomial is not strictly monotone on the interval
+	bool usable() const;
+
+	// returns t within the interval with $p(t) = val$, throws
+	// OutsideDomainException if there is no such t
+	float_type solve(float_type val) const;
+
+private:
+	static size_t const segments = 32;
+	static size_t const buckets = 2 * segments;
+	static size_t const max_newton_steps = 16;
+
+	data_type mCoeff;
+	data_type mDerivative;
+	float_type mLower;
+	float_type mUpper;
+	bool mUsable;
+	// +1 for rising, -1 for falling polynomials, values are stored multiplied
+	// by this sign so that the table is always rising
+	float_type mSign;
+
+	std::vector<float_type> mT;
+	std::vector<float_type> mValue;
+
+	float_type mBucketScale;
+	std::vector<uint32_t> mBucket;
+};
+
+Polynomial::InverseCache::InverseCache(
+    data_type const& coeff, float_type lower, float_type upper)
+    : mCoeff(coeff), mLower(lower), mUpper(upper), mUsable(false), mSign(1.),
+      mBucketScale(0.)
+{
+	for (size_t ii = 1; ii < mCoeff.size(); ++ii) {
+		mDerivative.push_back(ii * mCoeff[ii]);
+	}
+
+	// constants and empty intervals can not be inverted
+	while (!mDerivative.empty() && mDerivative.back() == 0.) {
+		mDerivative.pop_back();
+	}
+	if (mDerivative.empty() || !(lower < upper)) {
+		return;
+	}
+
+	// the derivative must not change its sign inside the interval
+	if (mDerivative.size() > 1) {
+		try {
+			for (auto const& root : complex_roots(mDerivative)) {
+				if (root.imag() == 0. && root.real() > lower && root.real() < upper) {
+					return;
+				}
+			}
+		} catch (std::runtime_error const&) {
+			return;
+		}
+	}
+
+	mT.resize(segments + 1);
+	mValue.resize(segments + 1);
+	for (size_t ii = 0; ii <= segments; ++ii) {
+		mT[ii] = (ii == segments) ? upper : lower + (upper - lower) * ii / segments;
+		mValue[ii] = horner::evaluate(mCoeff.data(), mCoeff.size(), mT[ii]);
+		if (!std::isfinite(mValue[ii])) {
+			return;
+		}
+	}
+
+	mSign = (mValue.back() > mValue.front()) ? 1. : -1.;
+	for (auto& val : mValue) {
+		val *= mSign;
+	}
+
+	// guards against loss of precision in the samples
+	for (size_t ii = 0; ii < segments; ++ii) {
+		if (!(mValue[ii] < mValue[ii + 1])) {
+			return;
+		}
+	}
+
+	float_type const range = mValue.back() - mValue.front();
+	mBucketScale = buckets / range;
+	if (!std::isfinite(mBucketScale)) {
+		return;
+	}
+
+	mBucket.resize(buckets);
+	size_t segment = 0;
+	for (size_t bb = 0; bb < buckets; ++bb) {
+		float_type const start = mValue.front() + range * bb / buckets;
+		while (segment + 1 < segments && mValue[segment + 1] <= start) {
+			++segment;
+		}
+		mBucket[bb] = segment;
+	}
+
+	mUsable = true;
+}
+
+bool Polynomial::InverseCache::matches(
+    data_type const& coeff, float_type lower, float_type upper) const
+{
+	return lower == mLower && upper == mUpper && coeff == mCoeff;
+}
+
+bool Polynomial::InverseCache::usable() const
+{
+	return mUsable;
+}
+
+float_type Polynomial::InverseCache::solve(float_type val) const
+{
+	float_type const target = mSign * val;
+
+	if (!(target >= mValue.front() && target <= mValue.back())) {
+		throw OutsideDomainException("No solutions or more than one solution in domain found.");
+	}
+
+	size_t const bucket = std::min(
+	    static_cast<size_t>((target - mValue.front()) * mBucketScale), buckets - 1);
+	size_t segment = mBucket[bucket];
+	while (segment > 0 && mValue[segment] > target) {
+		--segment;
+	}
+	while (segment + 1 < segments && mValue[segment + 1] < target) {
+		++segment;
+	}
+
+	// bracket [a, b] with p(a) <= target <= p(b)
+	float_type a = mT[segment];
+	float_type b = mT[segment + 1];
+	float_type const pa = mValue[segment];
+	float_type const pb = mValue[segment + 1];
+
+	if (target == pa) {
+		return a;
+	}
+	if (target == pb) {
+		return b;
+	}
+
+	float_type t = a + (b - a) * (target - pa) / (pb - pa);
+	for (size_t step = 0; step < max_newton_steps; ++step) {
+		float_type const f =
+		    mSign * horner::evaluate(mCoeff.data(), mCoeff.size(), t) - target;
+		if (f == 0.) {
+			break;
+		}
+
+		if (f < 0.) {
+			a = t;
+		} else {
+			b = t;
+		}
+
+		float_type const df =
+		    mSign * horner::evaluate(mDerivative.data(), mDerivative.size(), t);
+		float_type next = t - f / df;
+		if (next == t) {
+			break;
+		}
+
+		// fall back to bisection if Newton leaves the bracket
+		if (!(next > a && next < b)) {
+			next = a + (b - a) / 2;
+			if (!(next > a && next < b)) {
+				break;
+			}
+		}
+		t = next;
+	}
+	return t;
+}
+
 Polynomial::Polynomial(data_type const& coeff,
 					   float_type const& min,
                        float_type const& max)
-    : mData(coeff) {
+    : mData(coeff), mUseInverseCache(true), mRootFinder(COMPANION_MATRIX) {
 	setDomain(min, max);
 }
 
@@ -25,13 +359,7 @@ Polynomial::apply(float_type const& in, OutsideDomainBehavior outside_domain_beh
 {
 	float_type val = respectDomain(in, outside_domain_behavior);
 
-	float_type r = 0.;
-	unsigned exp = 0;
-	for (float_type const& d: mData)
-	{
-		r += d * pow(val, exp++);
-	}
-	return r;
+	return horner::evaluate(mData.data(), mData.size(), val);
 }
 
 float_type
@@ -43,6 +371,105 @@ Polynomial::reverseApply(float_type const& in, Transformation::OutsideDomainBeha
 
 	float_type const val = Polynomial::respectReverseDomain(in, outside_domain_behavior);
 
+	std::shared_ptr<InverseCache const> const cache =
+	    mUseInverseCache ? inverse_cache() : std::shared_ptr<InverseCache const>();
+
+	return solve(val, cache.get());
+}
+
+void
+Polynomial::apply(float_type const* in, float_type* out, size_t n, OutsideDomainBehavior outside_domain_behavior) const
+{
+	respectDomain(in, out, n, outside_domain_behavior);
+
+	horner::evaluate(mData.data(), mData.size(), out, out, n);
+}
+
+void
+Polynomial::reverseApply(float_type const* in, float_type* out, size_t n, Transformation::OutsideDomainBehavior outside_domain_behavior) const
+{
+	if (mData.size() < 2) {
+		throw std::runtime_error("Reverse transformation of constant not possible");
+	}
+
+	Polynomial::respectReverseDomain(in, out, n, outside_domain_behavior);
+
+	std::shared_ptr<InverseCache const> const cache =
+	    mUseInverseCache ? inverse_cache() : std::shared_ptr<InverseCache const>();
+
+	for (size_t ii = 0; ii < n; ++ii) {
+		out[ii] = solve(out[ii], cache.get());
+	}
+}
+
+float_type
+Polynomial::solve(float_type const val, InverseCache const* cache) const
+{
+	float_type t;
+	if (cache && cache->usable()) {
+		t = cache->solve(val);
+	} else {
+		float_type lower, upper;
+		if (mRootFinder != BRENT || !bracket(lower, upper)) {
+			return find_unique_root(val);
+		}
+		t = brent(mData, val, lower, upper);
+	}
+
+	// guard against rounding when mapping back from the solver variable
+	return std::min(std::max(from_solver_variable(t), mDomain.lower()),
+	                mDomain.upper());
+}
+
+std::shared_ptr<Polynomial::InverseCache const>
+Polynomial::inverse_cache() const
+{
+	float_type lower, upper;
+	if (!bracket(lower, upper)) {
+		return std::shared_ptr<InverseCache const>();
+	}
+
+	std::shared_ptr<InverseCache const> cache = std::atomic_load(&mInverseCache);
+	if (!cache || !cache->matches(mData, lower, upper)) {
+		// coefficients or domain changed since the cache was built
+		cache = std::make_shared<InverseCache const>(mData, lower, upper);
+		std::atomic_store(&mInverseCache, cache);
+	}
+	return cache;
+}
+
+bool
+Polynomial::solver_interval(float_type& lower, float_type& upper) const
+{
+	lower = mDomain.lower();
+	upper = mDomain.upper();
+	return std::isfinite(lower) && std::isfinite(upper);
+}
+
+bool
+Polynomial::bracket(float_type& lower, float_type& upper) const
+{
+	if (!solver_interval(lower, upper)) {
+		return false;
+	}
+
+	// the default domain ends at CALIBTIC_DOMAIN_MAX, which is no usable
+	// bracket, and the polynomial must not overflow at the bounds
+	float_type const max = std::numeric_limits<float_type>::max();
+	return std::abs(lower) < max && std::abs(upper) < max &&
+	       std::isfinite(horner::evaluate(mData.data(), mData.size(), lower)) &&
+	       std::isfinite(horner::evaluate(mData.data(), mData.size(), upper));
+}
+
+float_type
+Polynomial::from_solver_variable(float_type const t) const
+{
+	return t;
+}
+
+float_type
+Polynomial::find_unique_root(float_type const val) const
+{
 	data_type real_roots_in_domain = find_real_roots(val, true);
 	if (real_roots_in_domain.size() != 1) {
 		throw OutsideDomainException("No solutions or more than one solution in domain found.");
@@ -54,38 +481,14 @@ Polynomial::reverseApply(float_type const& in, Transformation::OutsideDomainBeha
 std::vector<std::complex<float_type>>
 Polynomial::find_roots(const float_type val) const
 {
-	const size_t dim = mData.size();
-
-	std::vector<std::complex<float_type>> result;
-
-	if (dim < 1) {
-		return result;
+	if (mData.empty()) {
+		return std::vector<std::complex<float_type>>();
 	}
 
-	Polynomial::data_type data(dim);
-	std::copy(mData.begin(), mData.end(), data.begin());
+	Polynomial::data_type data(mData);
 	data[0] -= val;
 
-	Polynomial::data_type tmp((dim - 1) * 2);
-	std::unique_ptr<gsl_poly_complex_workspace,
-		void (*)(gsl_poly_complex_workspace*)> w(
-			gsl_poly_complex_workspace_alloc(dim),
-			&gsl_poly_complex_workspace_free);
-	if (gsl_poly_complex_solve(data.data(), dim, w.get(), tmp.data())
-		!= GSL_SUCCESS)
-	{
-		throw std::runtime_error("Search for roots didn't converge");
-	}
-
-	// The results may be complex and are stored in an array
-	// { x0, x0' * i, x1, x1' * i, ... }
-	// First we check for complex solutions and throw in this case, then
-	// we pick only the real solutions
-	for (size_t ii = 0; ii < tmp.size(); ii += 2)
-	{
-		result.emplace_back(tmp[ii], tmp[ii+1]);
-	}
-	return result;
+	return complex_roots(data);
 }
 
 Polynomial::data_type
@@ -107,6 +510,26 @@ size_t Polynomial::degree() const
 	return mData.size() - 1;
 }
 
+void Polynomial::setUseInverseCache(bool enable)
+{
+	mUseInverseCache = enable;
+}
+
+bool Polynomial::getUseInverseCache() const
+{
+	return mUseInverseCache;
+}
+
+void Polynomial::setRootFinder(RootFinder root_finder)
+{
+	mRootFinder = root_finder;
+}
+
+Polynomial::RootFinder Polynomial::getRootFinder() const
+{
+	return mRootFinder;
+}
+
 Polynomial::data_type const&
 Polynomial::getData() const
 {
@@ -130,6 +553,14 @@ Polynomial::operator== (Transformation const& rhs) const
 	return (mData == _rhs->mData) && (mDomain == _rhs->mDomain);
 }
 
+size_t
+Polynomial::hash() const
+{
+	size_t seed = Transformation::hash();
+	boost::hash_range(seed, mData.begin(), mData.end());
+	return seed;
+}
+
 std::ostream&
 Polynomial::operator<< (std::ostream& os) const
 {
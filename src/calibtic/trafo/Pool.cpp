@@ -0,0 +1,91 @@
+#include "calibtic/trafo/Pool.h"
+
+#include <algorithm>
+#include <typeinfo>
+
+namespace calibtic {
+namespace trafo {
+
+namespace {
+
+size_t const min_purge_size = 1024;
+
+} // namespace
+
+Pool::Pool() :
+	mPurgeSize(min_purge_size)
+{
+}
+
+Pool::trafo_ptr Pool::intern(trafo_ptr const& trafo)
+{
+	if (!trafo) {
+		return trafo;
+	}
+
+	size_t const key = trafo->hash();
+
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	auto range = mPool.equal_range(key);
+	for (auto it = range.first; it != range.second;) {
+		trafo_ptr const pooled = it->second.lock();
+		if (!pooled) {
+			// released by all users
+			it = mPool.erase(it);
+			continue;
+		}
+		if (pooled == trafo || equivalent(*pooled, *trafo)) {
+			return pooled;
+		}
+		++it;
+	}
+
+	mPool.insert(std::make_pair(key, boost::weak_ptr<Transformation>(trafo)));
+
+	if (mPool.size() >= mPurgeSize) {
+		purge();
+		mPurgeSize = std::max(min_purge_size, 2 * mPool.size());
+	}
+
+	return trafo;
+}
+
+void Pool::purge()
+{
+	for (auto it = mPool.begin(); it != mPool.end();) {
+		if (it->second.expired()) {
+			it = mPool.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+size_t Pool::size() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	size_t alive = 0;
+	for (auto const& entry : mPool) {
+		alive += !entry.second.expired();
+	}
+	return alive;
+}
+
+void Pool::clear()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	mPool.clear();
+	mPurgeSize = min_purge_size;
+}
+
+bool Pool::equivalent(Transformation const& lhs, Transformation const& rhs)
+{
+	// operator== of some transformations ignores the domain
+	return typeid(lhs) == typeid(rhs) && lhs.getDomain() == rhs.getDomain() &&
+	       lhs.getReverseDomain() == rhs.getReverseDomain() && lhs == rhs;
+}
+
+} // trafo
+} // calibtic
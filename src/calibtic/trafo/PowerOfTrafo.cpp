@@ -1,5 +1,7 @@
 #include "calibtic/trafo/PowerOfTrafo.h"
 #include <iostream>
+#include <typeinfo>
+#include <boost/functional/hash.hpp>
 
 namespace calibtic {
 namespace trafo {
@@ -14,6 +16,10 @@ float_type PowerOfTrafo::reverseApply(float_type const& /*in*/, Transformation::
 	throw std::runtime_error("PowerOfTrafo cannot be reversed.");
 }
 
+void PowerOfTrafo::reverseApply(float_type const* /*in*/, float_type* /*out*/, size_t /*n*/, Transformation::OutsideDomainBehavior /*outside_domain_behavior*/) const {
+	throw std::runtime_error("PowerOfTrafo cannot be reversed.");
+}
+
 bool PowerOfTrafo::operator==(Transformation const& rhs) const {
 
 	// compare type
@@ -37,6 +43,14 @@ bool PowerOfTrafo::operator==(Transformation const& rhs) const {
 	}
 }
 
+double PowerOfTrafo::getPower() const {
+	return mPower;
+}
+
+PowerOfTrafo::trafo_ptr PowerOfTrafo::getTrafo() const {
+	return mTrafo;
+}
+
 boost::shared_ptr<PowerOfTrafo> PowerOfTrafo::create(double power, trafo_ptr t) {
 		return boost::shared_ptr<PowerOfTrafo>(new PowerOfTrafo(power, t));
 }
@@ -56,8 +70,40 @@ float_type PowerOfTrafo::apply(float_type const& in, OutsideDomainBehavior outsi
 	return res;
 }
 
+void PowerOfTrafo::apply(float_type const* in, float_type* out, size_t n, OutsideDomainBehavior outside_domain_behavior) const {
+
+	// see SumOfTrafos::apply
+	if (typeid(*this) == typeid(PowerOfTrafo)) {
+		mProgram.get(*this)->apply(in, out, n, outside_domain_behavior);
+		return;
+	}
+
+	respectDomain(in, out, n, outside_domain_behavior);
+
+	if(mTrafo) {
+		mTrafo->apply(out, out, n, Transformation::CLIP);
+	}
+
+	for (size_t ii = 0; ii < n; ++ii) {
+		out[ii] = pow(out[ii], mPower);
+	}
+}
+
+size_t PowerOfTrafo::hash() const {
+	size_t seed = Transformation::hash();
+	boost::hash_combine(seed, mPower);
+	boost::hash_combine(seed, mTrafo ? mTrafo->hash() : 0);
+	return seed;
+}
+
 std::ostream& PowerOfTrafo::operator<<(std::ostream& os) const {
-	os << "PowerOfTrafo: " << "(" << *mTrafo << ")^" << mPower << '\n';
+	os << "PowerOfTrafo: " << "(";
+	if (mTrafo) {
+		os << *mTrafo;
+	} else {
+		os << "x";
+	}
+	os << ")^" << mPower << '\n';
 
 	return os;
 }
@@ -0,0 +1,388 @@
+#include "calibtic/trafo/Program.h"
+
+#include <algorithm>
+#include <cmath>
+#include <typeinfo>
+#include <boost/core/null_deleter.hpp>
+
+#include "calibtic/trafo/Constant.h"
+#include "calibtic/trafo/Horner.h"
+#include "calibtic/trafo/NegativePowersPolynomial.h"
+#include "calibtic/trafo/Polynomial.h"
+#include "calibtic/trafo/PowerOfTrafo.h"
+#include "calibtic/trafo/SumOfTrafos.h"
+
+namespace calibtic {
+namespace trafo {
+
+namespace {
+
+// number of values processed per instruction in the batch version, the whole
+// stack of a chunk should stay in the L1 cache
+size_t const chunk_size = 256;
+
+// stack depth that is evaluated without allocation in the single value version
+size_t const small_stack_size = 16;
+
+// same check of the input as NegativePowersPolynomial::apply
+void check_nonzero(Transformation const& node, float_type const* values, size_t n)
+{
+	static_cast<NegativePowersPolynomial const&>(node).checkInput(values, n);
+}
+
+} // namespace
+
+Program::Program(trafo_ptr const& trafo) :
+	mTrafo(trafo),
+	mRootDomain(ROOT_RESPECT_DOMAIN),
+	mCheckRootNonZero(false),
+	mDepth(1),
+	mMaxDepth(1)
+{
+	if (!mTrafo) {
+		throw std::runtime_error("calibtic::Program: cannot compile null transformation");
+	}
+
+	compile(*mTrafo, true);
+
+	if (mInstructions.size() == 1) {
+		switch (mInstructions.front().op) {
+			case CONSTANT:
+				mRootDomain = ROOT_IGNORE_DOMAIN;
+				break;
+			case CALL:
+				mRootDomain = ROOT_CALL;
+				break;
+			default:
+				break;
+		}
+	}
+}
+
+void Program::compile(Transformation const& trafo, bool root)
+{
+	std::type_info const& type = typeid(trafo);
+
+	// only exact types are compiled, derived classes may change apply
+	if (type == typeid(SumOfTrafos)) {
+		SumOfTrafos const& sum = static_cast<SumOfTrafos const&>(trafo);
+		if (!root) {
+			emit(CLIP_DOMAIN, &trafo);
+		}
+		emit(PUSH_ZERO, &trafo);
+		for (auto const& t : sum.getTrafos()) {
+			if (!t) {
+				throw std::runtime_error("calibtic::Program: SumOfTrafos contains null transformation");
+			}
+			emit(PUSH_SECOND, &trafo);
+			compile(*t, false);
+			emit(ADD, &trafo);
+		}
+		emit(POP_SECOND, &trafo);
+	} else if (type == typeid(PowerOfTrafo)) {
+		PowerOfTrafo const& power = static_cast<PowerOfTrafo const&>(trafo);
+		if (!root) {
+			emit(CLIP_DOMAIN, &trafo);
+		}
+		if (power.getTrafo()) {
+			compile(*power.getTrafo(), false);
+		}
+		emit(POWER, &trafo, power.getPower());
+	} else if (type == typeid(Polynomial)) {
+		if (!root) {
+			emit(CLIP_DOMAIN, &trafo);
+		}
+		emit(POLYNOMIAL, &trafo);
+	} else if (type == typeid(NegativePowersPolynomial)) {
+		// the input is checked before it is clipped
+		if (root) {
+			mCheckRootNonZero = true;
+		} else {
+			emit(CHECK_NONZERO, &trafo);
+			emit(CLIP_DOMAIN, &trafo);
+		}
+		emit(NEGATIVE_POWERS, &trafo);
+	} else if (type == typeid(Constant)) {
+		// Constant ignores its domain
+		emit(CONSTANT, &trafo);
+	} else {
+		emit(CALL, &trafo);
+	}
+}
+
+void Program::emit(OpCode op, Transformation const* node, float_type power)
+{
+	switch (op) {
+		case PUSH_ZERO:
+		case PUSH_SECOND:
+			++mDepth;
+			mMaxDepth = std::max(mMaxDepth, mDepth);
+			break;
+		case ADD:
+		case POP_SECOND:
+			--mDepth;
+			break;
+		default:
+			break;
+	}
+
+	Instruction const instruction = {op, node, power};
+	mInstructions.push_back(instruction);
+}
+
+float_type Program::apply(float_type const& in,
+                          Transformation::OutsideDomainBehavior outside_domain_behavior) const
+{
+	switch (mRootDomain) {
+		case ROOT_CALL:
+			return mTrafo->apply(in, outside_domain_behavior);
+		case ROOT_IGNORE_DOMAIN:
+			return static_cast<Constant const&>(*mTrafo).getData();
+		case ROOT_RESPECT_DOMAIN:
+			break;
+	}
+
+	float_type small_stack[small_stack_size];
+	std::vector<float_type> large_stack;
+	float_type* stack = small_stack;
+	if (mMaxDepth > small_stack_size) {
+		large_stack.resize(mMaxDepth);
+		stack = large_stack.data();
+	}
+
+	if (mCheckRootNonZero) {
+		check_nonzero(*mTrafo, &in, 1);
+	}
+
+	size_t top = 0;
+	stack[top] = mTrafo->respectDomain(in, outside_domain_behavior);
+
+	for (auto const& ins : mInstructions) {
+		switch (ins.op) {
+			case CHECK_NONZERO:
+				check_nonzero(*ins.node, &stack[top], 1);
+				break;
+			case CLIP_DOMAIN:
+				stack[top] = ins.node->respectDomain(stack[top], Transformation::CLIP);
+				break;
+			case PUSH_ZERO:
+				stack[++top] = 0;
+				break;
+			case PUSH_SECOND:
+				stack[top + 1] = stack[top - 1];
+				++top;
+				break;
+			case ADD:
+				stack[top - 1] += stack[top];
+				--top;
+				break;
+			case POP_SECOND:
+				stack[top - 1] = stack[top];
+				--top;
+				break;
+			case POWER:
+				stack[top] = std::pow(stack[top], ins.power);
+				break;
+			case CONSTANT:
+				stack[top] = static_cast<Constant const*>(ins.node)->getData();
+				break;
+			case POLYNOMIAL:
+			case NEGATIVE_POWERS: {
+				Polynomial::data_type const& data =
+				    static_cast<Polynomial const*>(ins.node)->getData();
+				stack[top] = (ins.op == POLYNOMIAL)
+				    ? horner::evaluate(data.data(), data.size(), stack[top])
+				    : horner::evaluate_negative_powers(data.data(), data.size(), stack[top]);
+				break;
+			}
+			case CALL:
+				stack[top] = ins.node->apply(stack[top], Transformation::CLIP);
+				break;
+		}
+	}
+
+	return stack[top];
+}
+
+void Program::apply(float_type const* in, float_type* out, size_t n,
+                    Transformation::OutsideDomainBehavior outside_domain_behavior) const
+{
+	switch (mRootDomain) {
+		case ROOT_CALL:
+			mTrafo->apply(in, out, n, outside_domain_behavior);
+			return;
+		case ROOT_IGNORE_DOMAIN:
+			std::fill(out, out + n, static_cast<Constant const&>(*mTrafo).getData());
+			return;
+		case ROOT_RESPECT_DOMAIN:
+			break;
+	}
+
+	// all values are checked before anything is computed
+	if (mCheckRootNonZero) {
+		check_nonzero(*mTrafo, in, n);
+	}
+	mTrafo->respectDomain(in, out, n, outside_domain_behavior);
+
+	// the stack holds one chunk per level, levels are swapped instead of copied
+	std::vector<float_type> buffer((mMaxDepth - 1) * chunk_size);
+	std::vector<float_type*> stack(mMaxDepth);
+
+	for (size_t begin = 0; begin < n; begin += chunk_size) {
+		size_t const m = std::min(chunk_size, n - begin);
+
+		stack[0] = out + begin;
+		for (size_t level = 1; level < mMaxDepth; ++level) {
+			stack[level] = buffer.data() + (level - 1) * chunk_size;
+		}
+
+		size_t top = 0;
+		for (auto const& ins : mInstructions) {
+			float_type* const values = stack[top];
+			switch (ins.op) {
+				case CHECK_NONZERO:
+					check_nonzero(*ins.node, values, m);
+					break;
+				case CLIP_DOMAIN:
+					ins.node->respectDomain(values, values, m, Transformation::CLIP);
+					break;
+				case PUSH_ZERO:
+					++top;
+					std::fill(stack[top], stack[top] + m, 0.);
+					break;
+				case PUSH_SECOND:
+					std::copy(stack[top - 1], stack[top - 1] + m, stack[top + 1]);
+					++top;
+					break;
+				case ADD: {
+					float_type* const sum = stack[top - 1];
+					for (size_t ii = 0; ii < m; ++ii) {
+						sum[ii] += values[ii];
+					}
+					--top;
+					break;
+				}
+				case POP_SECOND:
+					std::swap(stack[top - 1], stack[top]);
+					--top;
+					break;
+				case POWER:
+					for (size_t ii = 0; ii < m; ++ii) {
+						values[ii] = std::pow(values[ii], ins.power);
+					}
+					break;
+				case CONSTANT:
+					std::fill(values, values + m,
+					          static_cast<Constant const*>(ins.node)->getData());
+					break;
+				case POLYNOMIAL: {
+					Polynomial::data_type const& data =
+					    static_cast<Polynomial const*>(ins.node)->getData();
+					horner::evaluate(data.data(), data.size(), values, values, m);
+					break;
+				}
+				case NEGATIVE_POWERS: {
+					Polynomial::data_type const& data =
+					    static_cast<Polynomial const*>(ins.node)->getData();
+					horner::evaluate_negative_powers(data.data(), data.size(), values, values, m);
+					break;
+				}
+				case CALL:
+					ins.node->apply(values, values, m, Transformation::CLIP);
+					break;
+			}
+		}
+
+		// the result may have been swapped into a buffer level
+		if (stack[0] != out + begin) {
+			std::copy(stack[0], stack[0] + m, out + begin);
+		}
+	}
+}
+
+size_t Program::size() const
+{
+	return mInstructions.size();
+}
+
+std::ostream& Program::operator<< (std::ostream& os) const
+{
+	os << "Program (" << mInstructions.size() << " instructions, stack depth "
+	   << mMaxDepth << "):\n";
+	for (auto const& ins : mInstructions) {
+		os << "    ";
+		switch (ins.op) {
+			case CHECK_NONZERO:
+				os << "CHECK_NONZERO";
+				break;
+			case CLIP_DOMAIN:
+				os << "CLIP_DOMAIN " << ins.node->getDomain();
+				break;
+			case PUSH_ZERO:
+				os << "PUSH_ZERO";
+				break;
+			case PUSH_SECOND:
+				os << "PUSH_SECOND";
+				break;
+			case ADD:
+				os << "ADD";
+				break;
+			case POP_SECOND:
+				os << "POP_SECOND";
+				break;
+			case POWER:
+				os << "POWER " << ins.power;
+				break;
+			case CONSTANT:
+				os << "CONSTANT " << static_cast<Constant const*>(ins.node)->getData();
+				break;
+			case POLYNOMIAL:
+				os << "POLYNOMIAL";
+				break;
+			case NEGATIVE_POWERS:
+				os << "NEGATIVE_POWERS";
+				break;
+			case CALL:
+				os << "CALL " << *ins.node;
+				break;
+		}
+		os << "\n";
+	}
+	return os;
+}
+
+boost::shared_ptr<Program> Program::create(trafo_ptr const& trafo)
+{
+	return boost::shared_ptr<Program>(new Program(trafo));
+}
+
+std::ostream& operator<< (std::ostream& os, Program const& p)
+{
+	return p.operator<<(os);
+}
+
+ProgramCache& ProgramCache::operator= (ProgramCache const&)
+{
+	reset();
+	return *this;
+}
+
+std::shared_ptr<Program const> ProgramCache::get(Transformation const& owner) const
+{
+	std::shared_ptr<Program const> program = std::atomic_load(&mProgram);
+	if (!program) {
+		// concurrent callers may compile twice, both programs are identical
+		program = std::make_shared<Program const>(
+		    Program::trafo_ptr(&owner, boost::null_deleter()));
+		std::atomic_store(&mProgram, program);
+	}
+	return program;
+}
+
+void ProgramCache::reset()
+{
+	std::atomic_store(&mProgram, std::shared_ptr<Program const>());
+}
+
+} // trafo
+} // calibtic
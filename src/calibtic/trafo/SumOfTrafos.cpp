@@ -1,5 +1,8 @@
 #include "calibtic/trafo/SumOfTrafos.h"
+#include <algorithm>
 #include <iostream>
+#include <typeinfo>
+#include <boost/functional/hash.hpp>
 
 namespace calibtic {
 namespace trafo {
@@ -14,6 +17,10 @@ float_type SumOfTrafos::reverseApply(float_type const& /*in*/, Transformation::O
 	throw std::runtime_error("SumOfTrafos cannot be reversed.");
 }
 
+void SumOfTrafos::reverseApply(float_type const* /*in*/, float_type* /*out*/, size_t /*n*/, Transformation::OutsideDomainBehavior /*outside_domain_behavior*/) const {
+	throw std::runtime_error("SumOfTrafos cannot be reversed.");
+}
+
 bool SumOfTrafos::operator==(Transformation const& rhs) const {
 
 	// compare type
@@ -38,6 +45,10 @@ bool SumOfTrafos::operator==(Transformation const& rhs) const {
 	return true;
 }
 
+SumOfTrafos::trafo_list const& SumOfTrafos::getTrafos() const {
+	return mTrafos;
+}
+
 boost::shared_ptr<SumOfTrafos> SumOfTrafos::create(trafo_list const& trafos) {
 	return boost::shared_ptr<SumOfTrafos>(new SumOfTrafos(trafos));
 }
@@ -48,16 +59,48 @@ float_type SumOfTrafos::apply(float_type const& in, OutsideDomainBehavior outsid
 
 	float_type res = 0;
 
-	for (auto t : mTrafos) {
+	for (auto const& t : mTrafos) {
 		res += t->apply(val);
 	}
 
 	return res;
 }
 
+void SumOfTrafos::apply(float_type const* in, float_type* out, size_t n, OutsideDomainBehavior outside_domain_behavior) const {
+
+	// nested composites are flattened into one pass per chunk, derived
+	// classes would be called back by the program
+	if (typeid(*this) == typeid(SumOfTrafos)) {
+		mProgram.get(*this)->apply(in, out, n, outside_domain_behavior);
+		return;
+	}
+
+	std::vector<float_type> val(n);
+	respectDomain(in, val.data(), n, outside_domain_behavior);
+
+	std::fill(out, out + n, 0.);
+
+	// summands use their own default behavior (CLIP), as in the single value version
+	std::vector<float_type> summand(n);
+	for (auto const& t : mTrafos) {
+		t->apply(val.data(), summand.data(), n, Transformation::CLIP);
+		for (size_t ii = 0; ii < n; ++ii) {
+			out[ii] += summand[ii];
+		}
+	}
+}
+
+size_t SumOfTrafos::hash() const {
+	size_t seed = Transformation::hash();
+	for (auto const& t : mTrafos) {
+		boost::hash_combine(seed, t ? t->hash() : 0);
+	}
+	return seed;
+}
+
 std::ostream& SumOfTrafos::operator<<(std::ostream& os) const {
 	os << "SumOfTrafos: " << '\n';
-	for (auto t : mTrafos) {
+	for (auto const& t : mTrafos) {
 		os << '\t' << *t << '\n';
 	}
 	return os;
@@ -1,7 +1,10 @@
 #include "calibtic/trafo/Transformation.h"
 
 #include <log4cxx/logger.h>
+#include <algorithm>
 #include <cmath>
+#include <typeinfo>
+#include <boost/functional/hash.hpp>
 
 namespace calibtic {
 namespace trafo {
@@ -17,6 +20,20 @@ Transformation::Transformation() {
 
 Transformation::~Transformation() {}
 
+void Transformation::apply(float_type const* in, float_type* out, size_t n,
+                           OutsideDomainBehavior outside_domain_behavior) const {
+	for (size_t ii = 0; ii < n; ++ii) {
+		out[ii] = apply(in[ii], outside_domain_behavior);
+	}
+}
+
+void Transformation::reverseApply(float_type const* in, float_type* out, size_t n,
+                                  OutsideDomainBehavior outside_domain_behavior) const {
+	for (size_t ii = 0; ii < n; ++ii) {
+		out[ii] = reverseApply(in[ii], outside_domain_behavior);
+	}
+}
+
 bool Transformation::in_domain(float_type const& val, const domain_type& domain) const {
 	return boost::icl::contains(domain, val);
 }
@@ -105,6 +122,77 @@ float_type Transformation::respectDomainImpl(
 	return val;
 }
 
+void Transformation::respectDomain(
+    float_type const* in, float_type* out, size_t n,
+    OutsideDomainBehavior outside_domain_behavior) const {
+	respectDomainImpl(in, out, n, outside_domain_behavior, mDomain);
+}
+
+void Transformation::respectReverseDomain(
+    float_type const* in, float_type* out, size_t n,
+    OutsideDomainBehavior outside_domain_behavior) const {
+	respectDomainImpl(in, out, n, outside_domain_behavior, mReverseDomain);
+}
+
+void Transformation::respectDomainImpl(
+    float_type const* in, float_type* out, size_t n,
+    OutsideDomainBehavior outside_domain_behavior,
+    const domain_type& domain) const {
+
+	switch (outside_domain_behavior) {
+		case OutsideDomainBehavior::THROW: {
+			// check all values before anything is written
+			for (size_t ii = 0; ii < n; ++ii) {
+				if (!in_domain(in[ii], domain)) {
+					std::stringstream err_msg;
+					err_msg << "Value " << in[ii] << " outside of domain " << domain;
+					throw OutsideDomainException(err_msg.str());
+				}
+			}
+			if (in != out) {
+				std::copy(in, in + n, out);
+			}
+			break;
+		}
+		case OutsideDomainBehavior::CLIP: {
+			float_type const lower = domain.lower();
+			float_type const upper = domain.upper();
+
+			size_t clipped = 0;
+			for (size_t ii = 0; ii < n; ++ii) {
+				float_type const val = in[ii];
+				if (in_domain(val, domain)) {
+					out[ii] = val;
+				} else {
+					out[ii] = (val <= lower) ? lower : upper;
+					++clipped;
+				}
+			}
+
+			if (clipped) {
+				LOG4CXX_WARN(_log, "Transformation::respectDomain: "
+				                       << clipped << " of " << n
+				                       << " input values outside of domain "
+				                       << domain << ", clipped.");
+			}
+			break;
+		}
+		case OutsideDomainBehavior::IGNORE: {
+			if (in != out) {
+				std::copy(in, in + n, out);
+			}
+			break;
+		}
+	}
+}
+
+size_t Transformation::hash() const {
+	size_t seed = typeid(*this).hash_code();
+	boost::hash_combine(seed, mDomain.lower());
+	boost::hash_combine(seed, mDomain.upper());
+	return seed;
+}
+
 std::ostream& operator<<(std::ostream& os, calibtic::trafo::Transformation const& t) {
 	return t.operator<<(os);
 }
@@ -2,22 +2,30 @@
 #include <sstream>
 #include <string>
 #include <cstdlib>
+#include <fstream>
 #include "test.h"
 #include "halco/common/iter_all.h"
 
 #include "calibtic/Collection.h"
 #include "calibtic/Calibration.h"
+#include "calibtic/CompactCalibration.h"
+#include "calibtic/Executor.h"
+#include "calibtic/util.h"
 #include "calibtic/trafo/Transformation.h"
 #include "calibtic/trafo/Polynomial.h"
 #include "calibtic/trafo/Constant.h"
 #include "calibtic/trafo/SumOfTrafos.h"
 #include "calibtic/trafo/PowerOfTrafo.h"
 #include "calibtic/trafo/InvQuadraticPol.h"
+#include "calibtic/trafo/Lookup.h"
 #include "calibtic/trafo/OneOverPolynomial.h"
 #include "calibtic/trafo/NegativePowersPolynomial.h"
 
 #include "calibtic/HMF/NeuronCalibration.h"
 #include "calibtic/HMF/NeuronCollection.h"
+#include "calibtic/HMF/HICANNCollection.h"
+#include "calibtic/HMF/BlockCollection.h"
+#include "calibtic/HMF/WaferCalibrationLoader.h"
 #include "calibtic/HMF/SharedCalibration.h"
 #include "calibtic/HMF/SynapseCalibration.h"
 #include "calibtic/HMF/SynapseRowCalibration.h"
@@ -28,6 +36,9 @@
 #include "calibtic/HMF/SynapseChainLengthCalibration.h"
 #include "calibtic/HMF/SynapseSwitchCalibration.h"
 #include "calibtic/HMF/SynapseSwitchCollection.h"
+#include "calibtic/HMF/ADC/ADCCalibration.h"
+#include "calibtic/HMF/ADC/QuadraticADCCalibration.h"
+#include "calibtic/HMF/ADC/LUTADCCalibration.h"
 
 using namespace calibtic;
 using namespace calibtic::trafo;
@@ -87,6 +98,89 @@ TYPED_TEST(BasicTest, NeuronCollection)
 	}
 }
 
+TYPED_TEST(BasicTest, PartialLoad)
+{
+	MetaData md;
+	HMF::NeuronCollection set0;
+	set0.setDefaults();
+	set0.setSpeedup(1337);
+	shared_ptr<HMF::NeuronCalibration> calib(new HMF::NeuronCalibration);
+	calib->reset(0, Constant::create(4.2));
+	set0.erase(5);
+	set0.insert(5, calib);
+	TestFixture::backend->store("partial", md, set0);
+
+	HMF::NeuronCollection set1;
+	// repeated keys are loaded once
+	TestFixture::backend->load("partial", md, set1, {5, 3, 1000, 5});
+	ASSERT_EQ(2, set1.size());
+	EXPECT_EQ(1337, set1.getSpeedup());
+	EXPECT_TRUE(*set0.at(3) == *set1.at(3));
+	EXPECT_TRUE(*calib == *set1.at(5));
+
+	HMF::BlockCollection blocks0;
+	blocks0.setDefaults();
+	TestFixture::backend->store("partial", md, blocks0);
+
+	HMF::BlockCollection blocks1;
+	TestFixture::backend->load("partial", md, blocks1, {1});
+	ASSERT_EQ(1, blocks1.size());
+	EXPECT_TRUE(*blocks0.at(1) == *blocks1.at(1));
+}
+
+TYPED_TEST(BasicTest, WaferCalibrationLoader)
+{
+	MetaData md;
+	for (size_t hicann : {0, 1, 5}) {
+		HMF::HICANNCollection hc;
+		hc.setSpeedup(100 + hicann);
+		TestFixture::backend->store(HMF::WaferCalibrationLoader::name(3, hicann), md, hc);
+	}
+	EXPECT_EQ("w3-h5", HMF::WaferCalibrationLoader::name(3, 5));
+
+	HMF::WaferCalibrationLoader loader(TestFixture::backend, Executor::create(4), 2);
+	auto const loaded = loader.load(3, {5, 0, 2, 1, 5, 7});
+	ASSERT_EQ(3, loaded.size());
+	for (auto const& hc : loaded) {
+		EXPECT_EQ(100 + hc.first, hc.second->getSpeedup());
+	}
+
+	ASSERT_EQ(2, loader.errors().size());
+	EXPECT_EQ(1, loader.errors().count(2));
+	EXPECT_EQ(1, loader.errors().count(7));
+	EXPECT_THROW(loader.throwOnErrors(), std::runtime_error);
+
+	loader.load(3, {0});
+	EXPECT_TRUE(loader.errors().empty());
+	EXPECT_NO_THROW(loader.throwOnErrors());
+}
+
+TYPED_TEST(BasicTest, AsyncLoadStore)
+{
+	shared_ptr<HMF::NeuronCollection> set0(new HMF::NeuronCollection);
+	set0->setSpeedup(1337);
+	shared_ptr<Calibration> calib0(new Calibration(1));
+	calib0->reset(0, Constant::create(4.2));
+
+	auto stored = TestFixture::backend->store_async("async", MetaData(7), set0);
+	TestFixture::backend->store_async("async_calib", MetaData(), calib0).get();
+
+	// issued after the store, runs after it
+	shared_ptr<HMF::NeuronCollection> set1(new HMF::NeuronCollection);
+	auto loaded = TestFixture::backend->load_async("async", set1);
+	shared_ptr<Calibration> calib1(new Calibration);
+	auto loaded_calib = TestFixture::backend->load_async("async_calib", calib1);
+	auto missing = TestFixture::backend->load_async("async_missing", set1);
+
+	TestFixture::backend->wait();
+	stored.get();
+	EXPECT_EQ(7, loaded.get().getID());
+	EXPECT_EQ(1337, set1->getSpeedup());
+	loaded_calib.get();
+	EXPECT_TRUE(*calib0 == *calib1);
+	EXPECT_THROW(missing.get(), std::runtime_error);
+}
+
 class TestableCalibration : public Calibration
 {
 public:
@@ -302,8 +396,221 @@ TEST(CalibticTransformation, PowerOfTrafo)
 
 }
 
+TEST(CalibticTransformation, BatchApply)
+{
+	std::vector<boost::shared_ptr<Transformation> > const trafos = {
+	    boost::shared_ptr<Transformation>(new Polynomial({1, 2, 3}, 0, 50)),
+	    boost::shared_ptr<Transformation>(new NegativePowersPolynomial({1, 2, 3}, 0.1, 50)),
+	    boost::shared_ptr<Transformation>(new OneOverPolynomial({1, 2, 3}, 0, 50)),
+	    boost::shared_ptr<Transformation>(new Constant(5)),
+	    boost::shared_ptr<Transformation>(
+	        new InvQuadraticPol(InvQuadraticPol::data_type{{-2, 4, 1, 2}})),
+	    boost::shared_ptr<Transformation>(new Lookup({1, 2, 4, 8, 16, 32}, 3)),
+	    boost::shared_ptr<Transformation>(new Lookup({32, 16, 8, 4, 2, 1}, 3)),
+	    boost::shared_ptr<Transformation>(new SumOfTrafos(
+	        {boost::shared_ptr<Transformation>(new Polynomial({1, 0.5}, 0, 20)),
+	         boost::shared_ptr<Transformation>(new Constant(7))})),
+	    boost::shared_ptr<Transformation>(new PowerOfTrafo(
+	        3, boost::shared_ptr<Transformation>(new OneOverPolynomial({5., 1}))))};
+
+	std::vector<float_type> in;
+	for (size_t ii = 0; ii < 100; ++ii) {
+		in.push_back(0.5 * ii + 0.25);
+	}
+
+	for (auto const& t : trafos) {
+		std::vector<float_type> out(in.size());
+		t->apply(in.data(), out.data(), in.size(), Transformation::CLIP);
+		for (size_t ii = 0; ii < in.size(); ++ii) {
+			ASSERT_EQ(t->apply(in[ii], Transformation::CLIP), out[ii]) << *t;
+		}
+
+		// in place
+		std::vector<float_type> inplace(in);
+		t->apply(inplace.data(), inplace.data(), inplace.size(), Transformation::CLIP);
+		ASSERT_EQ(out, inplace) << *t;
+	}
+
+	Polynomial const p({1, 2, 3}, 0, 50);
+	std::vector<float_type> forward(in.size());
+	p.apply(in.data(), forward.data(), in.size());
+	std::vector<float_type> reverse(in.size());
+	p.reverseApply(forward.data(), reverse.data(), forward.size());
+	for (size_t ii = 0; ii < in.size(); ++ii) {
+		ASSERT_EQ(p.reverseApply(forward[ii]), reverse[ii]);
+		ASSERT_NEAR(in[ii], reverse[ii], 1e-9);
+	}
+
+	// the whole batch is checked before anything is written
+	Polynomial const p10({1, 2, 3}, 0, 10);
+	std::vector<float_type> untouched(in.size(), -1.);
+	ASSERT_THROW(p10.apply(in.data(), untouched.data(), in.size(), Transformation::THROW),
+	             OutsideDomainException);
+	ASSERT_EQ(std::vector<float_type>(in.size(), -1.), untouched);
+}
+
+TEST(CalibticTransformation, CompactCalibration)
+{
+	Calibration calib(6);
+	calib.reset(0, boost::shared_ptr<Transformation>(new Polynomial({1, 2, 3}, 0, 20)));
+	calib.reset(1, boost::shared_ptr<Transformation>(new NegativePowersPolynomial({1, 2, 3}, 0.1, 50)));
+	calib.reset(2, boost::shared_ptr<Transformation>(new Constant(5)));
+	calib.reset(3, boost::shared_ptr<Transformation>(new Lookup({1, 2, 4, 8, 16, 32}, 3)));
+	calib.reset(4, boost::shared_ptr<Transformation>(new OneOverPolynomial({1, 2, 3}, 0, 50)));
+
+	Calibration other(2);
+	other.reset(1, boost::shared_ptr<Transformation>(new Polynomial({-1, 0.5}, 2, 5)));
+
+	CompactCalibration compact(calib);
+	ASSERT_EQ(1u, compact.push_back(other));
+	ASSERT_EQ(2u, compact.size());
+	ASSERT_EQ(6u, compact.size(0));
+	ASSERT_EQ(2u, compact.size(1));
+
+	std::vector<float_type> in;
+	for (size_t ii = 0; ii < 100; ++ii) {
+		in.push_back(0.5 * ii + 0.25);
+	}
+
+	for (auto const behavior : {Transformation::CLIP, Transformation::IGNORE}) {
+		for (size_t index = 0; index < compact.size(); ++index) {
+			Calibration const& c = index ? other : calib;
+			for (size_t key = 0; key < c.size(); ++key) {
+				ASSERT_EQ(c.exists(key), compact.exists(index, key));
+				if (!c.exists(key)) {
+					ASSERT_THROW(compact.apply(index, key, 1.), std::runtime_error);
+					continue;
+				}
+
+				std::vector<float_type> out(in.size());
+				compact.apply(index, key, in.data(), out.data(), in.size(), behavior);
+				for (size_t ii = 0; ii < in.size(); ++ii) {
+					float_type const expected = c.at(key)->apply(in[ii], behavior);
+					ASSERT_EQ(expected, compact.apply(index, key, in[ii], behavior));
+					ASSERT_EQ(expected, out[ii]);
+				}
+			}
+		}
+	}
+
+	ASSERT_THROW(compact.apply(0, 0, 25., Transformation::THROW), OutsideDomainException);
+	ASSERT_THROW(compact.apply(1, 2, 1.), std::out_of_range);
+	ASSERT_NEAR(3., compact.reverseApply(1, 1, 0.5), 1e-12);
+
+	// inline transformations are copied
+	boost::dynamic_pointer_cast<Polynomial>(calib.at(0))->getData()[0] = 2;
+	ASSERT_EQ(1 + 2 * 3. + 3 * 9., compact.apply(0, 0, 3.));
+
+	// inputs of 0 are checked like in NegativePowersPolynomial::apply
+	Calibration zero(1);
+	zero.reset(0, boost::shared_ptr<Transformation>(new NegativePowersPolynomial({1, 0.5}, -1, 1)));
+	CompactCalibration const compact_zero(zero);
+	std::vector<float_type> const with_zero = {0.5, 0., 1.};
+
+	bool throws = false;
+	std::vector<float_type> single;
+	for (float_type const val : with_zero) {
+		try {
+			single.push_back(zero.at(0)->apply(val));
+		} catch (std::runtime_error const&) {
+			throws = true;
+			ASSERT_THROW(compact_zero.apply(0, 0, val), std::runtime_error);
+			continue;
+		}
+		ASSERT_EQ(single.back(), compact_zero.apply(0, 0, val));
+	}
+
+	std::vector<float_type> batch(with_zero.size());
+	if (throws) {
+		ASSERT_THROW(compact_zero.apply(0, 0, with_zero.data(), batch.data(), batch.size()),
+		             std::runtime_error);
+	} else {
+		compact_zero.apply(0, 0, with_zero.data(), batch.data(), batch.size());
+		ASSERT_EQ(single, batch);
+	}
+}
+
 // transform PyNN parameters to DAC values, compare
 // with results calculated manually
+TEST(Executor, ParallelFor)
+{
+	for (size_t threads : {1, 2, 7}) {
+		Executor executor(threads);
+		ASSERT_EQ(threads, executor.size());
+
+		// every index is visited exactly once
+		std::vector<int> visits(1000, 0);
+		executor.parallel_for(visits.size(), [&](size_t begin, size_t end) {
+			for (size_t ii = begin; ii < end; ++ii) {
+				++visits[ii];
+			}
+		});
+		ASSERT_EQ(std::vector<int>(visits.size(), 1), visits);
+
+		// nested calls run in the calling thread
+		std::vector<int> nested(64, 0);
+		executor.parallel_for(8, [&](size_t begin, size_t end) {
+			for (size_t ii = begin; ii < end; ++ii) {
+				executor.parallel_for(8, [&](size_t b, size_t e) {
+					for (size_t jj = b; jj < e; ++jj) {
+						++nested[8 * ii + jj];
+					}
+				}, 3);
+			}
+		}, 1);
+		ASSERT_EQ(std::vector<int>(nested.size(), 1), nested);
+
+		// the exception of the first failing range is rethrown
+		try {
+			executor.parallel_for(100, [](size_t begin, size_t) {
+				if (begin >= 50) {
+					throw std::runtime_error(std::to_string(begin));
+				}
+			}, 10);
+			FAIL();
+		} catch (std::runtime_error const& e) {
+			ASSERT_EQ(std::string("50"), e.what());
+		}
+	}
+}
+
+TEST(Philox, KnownAnswer)
+{
+	// test vectors of the reference implementation (Random123)
+	typedef Philox4x32::counter_type counter_type;
+	typedef Philox4x32::key_type key_type;
+	EXPECT_EQ((counter_type{{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}}),
+	          Philox4x32::block(counter_type{{0, 0, 0, 0}}, key_type{{0, 0}}));
+	EXPECT_EQ((counter_type{{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}}),
+	          Philox4x32::block(
+	              counter_type{{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}},
+	              key_type{{0xffffffff, 0xffffffff}}));
+	EXPECT_EQ((counter_type{{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}}),
+	          Philox4x32::block(
+	              counter_type{{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}},
+	              key_type{{0xa4093822, 0x299f31d0}}));
+
+	// streams are reproducible and differ from each other
+	Philox4x32 a(1, 2), b(1, 2), c(1, 3);
+	std::vector<uint32_t> va, vb, vc;
+	for (size_t ii = 0; ii < 10; ++ii) {
+		va.push_back(a());
+		vb.push_back(b());
+		vc.push_back(c());
+	}
+	ASSERT_EQ(va, vb);
+	ASSERT_NE(va, vc);
+
+	double sum = 0;
+	for (size_t ii = 0; ii < 10000; ++ii) {
+		double const u = canonical(a);
+		ASSERT_LE(0., u);
+		ASSERT_GT(1., u);
+		sum += u;
+	}
+	EXPECT_NEAR(0.5, sum / 10000, 0.02);
+}
+
 TEST(Calibtic, CalibBioToHw)
 {
 	using namespace HMF;
@@ -697,6 +1004,78 @@ TEST(Calibtic, NeuronCalibAdExSpecialCases)
 	}
 }
 
+TEST(Calibtic, NeuronCalibSharedDefault)
+{
+	using namespace HMF;
+	typedef NeuronCalibrationParameters::Calibrations::calib c;
+
+	NeuronCalibration defaults;
+	defaults.setDefaults();
+
+	// uninitialized parameters fall back to the shared default
+	std::vector<NeuronCalibration> neurons(100);
+	for (auto const& neuron : neurons) {
+		ASSERT_EQ(defaults.to_dac(0.5, c::E_l), neuron.to_dac(0.5, c::E_l));
+	}
+
+	// copies share the default instead of owning it
+	NeuronCalibration copy;
+	copy.copy(neurons[0]);
+	neurons.clear();
+	ASSERT_EQ(defaults.to_dac(0.5, c::V_t), copy.to_dac(0.5, c::V_t));
+
+	NeuronCalibration without_default(false);
+	ASSERT_THROW(without_default.to_dac(0.5, c::E_l), std::runtime_error);
+}
+
+TEST(Calibtic, NeuronCollectionBatch)
+{
+	using namespace HMF;
+
+	NeuronCollection collection;
+	collection.setDefaults();
+	// uninitialized calibration, falls back to the default neuron by neuron
+	collection.erase(7);
+	collection.insert(7, NeuronCalibration::create());
+
+	size_t const n = 32;
+	std::vector<EIF_cond_exp_isfa_ista> bio(n);
+	std::vector<IF_cond_exp> lif(n);
+	std::vector<size_t> ids(n);
+	for (size_t ii = 0; ii < n; ++ii) {
+		bio[ii].tau_m = 5. + ii;
+		bio[ii].v_rest = -70. + ii % 10;
+		bio[ii].a = (ii % 2) ? 4. : 0.;
+		bio[ii].delta_T = (ii % 3) ? 2. : 0.;
+		lif[ii].tau_syn_E = 1. + 0.1 * ii;
+		ids[ii] = (5 * ii) % n;
+	}
+
+	std::vector<HWNeuronParameter> hw(n), hw_lif(n);
+	collection.applyNeuronCalibration(bio.data(), ids.data(), n, hw.data());
+	collection.applyNeuronCalibration(lif.data(), ids.data(), n, hw_lif.data());
+
+	for (size_t ii = 0; ii < n; ++ii) {
+		ASSERT_EQ(collection.applyNeuronCalibration(bio[ii], ids[ii]).parameters(),
+		          hw[ii].parameters()) << ii;
+		ASSERT_EQ(collection.applyNeuronCalibration(lif[ii], ids[ii]).parameters(),
+		          hw_lif[ii].parameters()) << ii;
+	}
+
+	// same result on several threads
+	Executor executor(4);
+	std::vector<HWNeuronParameter> hw_parallel(n);
+	collection.applyNeuronCalibration(bio.data(), ids.data(), n, hw_parallel.data(), executor);
+	for (size_t ii = 0; ii < n; ++ii) {
+		ASSERT_EQ(hw[ii].parameters(), hw_parallel[ii].parameters()) << ii;
+	}
+
+	collection.erase(3);
+	ASSERT_THROW(
+		collection.applyNeuronCalibration(bio.data(), ids.data(), n, hw.data()),
+		std::runtime_error);
+}
+
 /// checks for the default transformations, whether the boundaries are ok,
 /// First retrieve the boundaries, then apply the transformation, finally
 /// try to transform back via reverseApply.
@@ -853,9 +1232,305 @@ TEST(Calibtic, SynapseCalibration)
 		ASSERT_EQ(HICANN::SynapseWeight(dw), sc.getDigitalWeight(aw));
 	}
 	ASSERT_TRUE(sc.check_monotonic_increasing());
+
+	// seeded stochastic rounding is reproducible and unbiased
+	double const aw = 0.25 * sc.getAnalogWeight(HICANN::SynapseWeight(3)) +
+	                  0.75 * sc.getAnalogWeight(HICANN::SynapseWeight(4));
+	size_t rounded_up = 0;
+	for (uint64_t synapse = 0; synapse < 10000; ++synapse) {
+		HICANN::SynapseWeight const dw = sc.getDigitalWeight(aw, 42, synapse);
+		ASSERT_EQ(dw, sc.getDigitalWeight(aw, 42, synapse));
+		ASSERT_TRUE(dw == HICANN::SynapseWeight(3) || dw == HICANN::SynapseWeight(4));
+		rounded_up += (dw == HICANN::SynapseWeight(4));
+	}
+	EXPECT_NEAR(7500, rounded_up, 200);
+
+	// batch version, including weights outside of the hardware range
+	std::vector<double> analog;
+	for (int ii = -10; ii < 1200; ++ii) {
+		analog.push_back(ii);
+	}
+	std::vector<HICANN::SynapseWeight> digital(analog.size());
+	sc.getDigitalWeights(analog.data(), analog.size(), digital.data(), 7, 100);
+	for (size_t ii = 0; ii < analog.size(); ++ii) {
+		ASSERT_EQ(sc.getDigitalWeight(analog[ii], 7, 100 + ii), digital[ii]) << analog[ii];
+	}
+	ASSERT_EQ(HICANN::SynapseWeight(HICANN::SynapseWeight::min), digital.front());
+	ASSERT_EQ(HICANN::SynapseWeight(HICANN::SynapseWeight::max), digital.back());
+
+	// replacing the transformation updates the weight table
+	sc.reset(0, Polynomial::create({0, 10}));
+	ASSERT_EQ(HICANN::SynapseWeight(5), sc.getDigitalWeight(50., 7, 0));
+
 	sc.reset(0,Polynomial::create({0,-1}));
 	ASSERT_EQ(sc.getAnalogWeight(HICANN::SynapseWeight(1)), -1);
 	ASSERT_FALSE(sc.check_monotonic_increasing());
+	ASSERT_EQ(HICANN::SynapseWeight(HICANN::SynapseWeight::min), sc.getDigitalWeight(-5., 7, 0));
+}
+
+TEST(Calibtic, QuadraticADCCalibration)
+{
+	using namespace HMF::ADC;
+
+	ADCCalibration regular = ADCCalibration::getDefaultCalibration();
+	regular.reset(0, Polynomial::create({2.01354, -0.000661921, 5.55852e-09}));
+	boost::shared_ptr<QuadraticADCCalibration> quadratic =
+		ADCCalibration::convertToQuadraticADCCalibration(regular);
+
+	// every sample value, odd length to cover the remainder loops
+	std::vector<uint16_t> data(65536 + 13);
+	for (size_t ii = 0; ii < data.size(); ++ii) {
+		data[ii] = ii;
+	}
+	ADCCalibration::key_type const channel(0);
+
+	std::vector<float> const expected = quadratic->apply(channel, data);
+	std::vector<float> const generic = regular.apply(channel, data);
+	for (size_t ii = 0; ii < data.size(); ++ii) {
+		ASSERT_FLOAT_EQ(generic[ii], expected[ii]);
+	}
+
+	std::vector<float> buffer;
+	regular.apply(channel, data, buffer);
+	ASSERT_EQ(generic, buffer);
+	quadratic->apply(channel, data, buffer);
+	ASSERT_EQ(expected, buffer);
+
+	// streamed in chunks that do not divide the trace
+	for (ADCCalibration* calib : {&regular, static_cast<ADCCalibration*>(quadratic.get())}) {
+		size_t read = 0;
+		std::vector<float> streamed;
+		size_t const total = calib->applyChunked(channel,
+			[&](std::vector<uint16_t>& raw, size_t n) {
+				n = std::min(n, data.size() - read);
+				raw.insert(raw.end(), data.begin() + read, data.begin() + read + n);
+				read += n;
+			},
+			[&](float const* voltages, size_t n) {
+				streamed.insert(streamed.end(), voltages, voltages + n);
+			}, 1000);
+		ASSERT_EQ(data.size(), total);
+		ASSERT_EQ(calib == &regular ? generic : expected, streamed);
+	}
+
+	// a source delivering more than requested is rejected
+	ASSERT_THROW(regular.applyChunked(channel,
+		[&](std::vector<uint16_t>& raw, size_t n) {
+			raw.assign(data.begin(), data.begin() + n + 1);
+		},
+		[](float const*, size_t) {}, 1000), std::length_error);
+
+	for (auto kernel : {simd::SCALAR, simd::AVX2, simd::AVX512}) {
+		if (!simd::supported(kernel)) {
+			continue;
+		}
+		for (size_t n : {size_t(0), size_t(7), size_t(31), data.size()}) {
+			std::fill(buffer.begin(), buffer.end(), -1.);
+			quadratic->apply(channel, data.data(), buffer.data(), n, kernel);
+			for (size_t ii = 0; ii < data.size(); ++ii) {
+				ASSERT_EQ(ii < n ? expected[ii] : -1.f, buffer[ii]) << kernel << " " << n;
+			}
+		}
+	}
+}
+
+TEST(Calibtic, LUTADCCalibration)
+{
+	using namespace HMF::ADC;
+
+	// cubic, which QuadraticADCCalibration does not support
+	ADCCalibration regular = ADCCalibration::getDefaultCalibration();
+	regular.reset(0, Polynomial::create({2.01354, -0.000661921, 5.55852e-09, -1e-13}));
+	ASSERT_ANY_THROW(ADCCalibration::convertToQuadraticADCCalibration(regular));
+
+	std::vector<uint16_t> data(65536);
+	for (size_t ii = 0; ii < data.size(); ++ii) {
+		data[ii] = (ii * 40503) % data.size();
+	}
+	ADCCalibration::key_type const channel(0);
+	std::vector<float> const expected = regular.apply(channel, data);
+
+	for (unsigned bits : {12u, 16u}) {
+		boost::shared_ptr<LUTADCCalibration> lut =
+			ADCCalibration::convertToLUTADCCalibration(regular, bits);
+		ASSERT_EQ(bits, lut->getBits());
+		// samples exceeding 12 bit are converted by the transformation
+		ASSERT_EQ(expected, lut->apply(channel, data));
+
+		// replacing the transformation rebuilds the table
+		lut->reset(0, Polynomial::create({1., 2.}));
+		ASSERT_EQ(3.f, lut->apply(channel, std::vector<uint16_t>{1})[0]);
+	}
+
+	ASSERT_THROW(LUTADCCalibration(17), std::invalid_argument);
+	ASSERT_THROW(LUTADCCalibration().apply(channel, data), std::runtime_error);
+}
+
+namespace {
+
+// rejects all values outside of its domain, whatever the caller asks for
+class ThrowingPolynomial : public Polynomial
+{
+public:
+	using Polynomial::Polynomial;
+	using Polynomial::apply;
+
+	virtual void apply(float_type const* in, float_type* out, size_t n,
+	                   Transformation::OutsideDomainBehavior) const
+	{
+		Polynomial::apply(in, out, n, Transformation::THROW);
+	}
+};
+
+} // namespace
+
+TEST(Calibtic, LUTADCCalibrationDomain)
+{
+	using namespace HMF::ADC;
+
+	ADCCalibration regular = ADCCalibration::getDefaultCalibration();
+	regular.reset(0, shared_ptr<Polynomial>(new ThrowingPolynomial(
+		Polynomial::data_type{2.01354, -0.000661921, 5.55852e-09}, 100., 3000.)));
+
+	std::vector<uint16_t> data;
+	for (uint16_t sample = 100; sample <= 3000; sample += 7) {
+		data.push_back(sample);
+	}
+	ADCCalibration::key_type const channel(0);
+	std::vector<float> const expected = regular.apply(channel, data);
+
+	// the table covers the domain only, building it does not throw
+	boost::shared_ptr<LUTADCCalibration> lut =
+		ADCCalibration::convertToLUTADCCalibration(regular, 12);
+	ASSERT_EQ(expected, lut->apply(channel, data));
+
+	// samples outside of the domain are handed to the transformation
+	ASSERT_THROW(lut->apply(channel, std::vector<uint16_t>{99}), OutsideDomainException);
+	ASSERT_THROW(lut->apply(channel, std::vector<uint16_t>{3001}), OutsideDomainException);
+	ASSERT_THROW(lut->apply(channel, std::vector<uint16_t>{5000}), OutsideDomainException);
+}
+
+TEST(Calibtic, ADCTraceStatistics)
+{
+	using namespace HMF::ADC;
+
+	ADCCalibration regular = ADCCalibration::getDefaultCalibration();
+	ADCCalibration::key_type const channel(0);
+
+	std::vector<uint16_t> data(10007);
+	for (size_t ii = 0; ii < data.size(); ++ii) {
+		data[ii] = 1000 + (ii * 7919) % 2000;
+	}
+	std::vector<float> const voltages = regular.apply(channel, data);
+
+	double sum = 0.;
+	for (float v : voltages) {
+		sum += v;
+	}
+	double const mean = sum / voltages.size();
+	double m2 = 0.;
+	for (float v : voltages) {
+		m2 += (v - mean) * (v - mean);
+	}
+
+	TraceStatistics const stats =
+		regular.statistics(channel, data, TraceStatistics(10, 0.6, 1.2));
+	ASSERT_EQ(data.size(), stats.count());
+	EXPECT_NEAR(mean, stats.mean(), 1e-12);
+	EXPECT_NEAR(m2 / voltages.size(), stats.variance(), 1e-12);
+	EXPECT_EQ(*std::min_element(voltages.begin(), voltages.end()), stats.min());
+	EXPECT_EQ(*std::max_element(voltages.begin(), voltages.end()), stats.max());
+
+	std::vector<size_t> const histogram = stats.histogram();
+	ASSERT_EQ(10, histogram.size());
+	size_t binned = stats.underflow() + stats.overflow();
+	for (size_t bin = 0; bin < histogram.size(); ++bin) {
+		size_t expected = 0;
+		for (float v : voltages) {
+			expected += v >= stats.binEdge(bin) && v < stats.binEdge(bin + 1);
+		}
+		EXPECT_EQ(expected, histogram[bin]);
+		binned += histogram[bin];
+	}
+	EXPECT_EQ(data.size(), binned);
+
+	// value by value, and merged from parts
+	TraceStatistics single(10, 0.6, 1.2);
+	TraceStatistics first(10, 0.6, 1.2);
+	TraceStatistics second(10, 0.6, 1.2);
+	for (size_t ii = 0; ii < voltages.size(); ++ii) {
+		single.push(voltages[ii]);
+		(ii < 3000 ? first : second).push(voltages[ii]);
+	}
+	first.merge(second);
+	for (TraceStatistics const& other : {single, first}) {
+		EXPECT_EQ(stats.count(), other.count());
+		EXPECT_NEAR(stats.mean(), other.mean(), 1e-12);
+		EXPECT_NEAR(stats.variance(), other.variance(), 1e-12);
+		EXPECT_EQ(stats.histogram(), other.histogram());
+	}
+	ASSERT_THROW(first.merge(TraceStatistics()), std::invalid_argument);
+
+	DataPoint const point = stats.toDataPoint(0.9);
+	EXPECT_FLOAT_EQ(stats.mean(), point.mean);
+	EXPECT_FLOAT_EQ(stats.std(), point.std);
+}
+
+TEST(Calibtic, ADCPolynomialFit)
+{
+	using namespace HMF::ADC;
+
+	// one measurement per channel of a known quadratic with small noise
+	std::vector<VoltageMeasurement> voltages(8);
+	for (size_t channel = 0; channel < voltages.size(); ++channel) {
+		for (size_t ii = 0; ii < 20; ++ii) {
+			double const mean = 200. + 180. * ii;
+			double const ref = 1.8 - (4e-4 + 1e-5 * channel) * mean + 1e-8 * mean * mean
+				+ ((ii % 3) - 1.) * 1e-4;
+			voltages[channel].push_back(DataPoint(ref, mean, 1e-3 * (1 + ii % 2)));
+		}
+	}
+
+	ADCCalibration adc;
+	std::vector<PolynomialFit> const fits = adc.makePolynomialTrafos(voltages);
+	ASSERT_EQ(8, fits.size());
+	ASSERT_TRUE(adc.isComplete());
+
+	PolynomialFitter normal(PolynomialFitter::NORMAL_EQUATIONS);
+	for (size_t channel = 0; channel < voltages.size(); ++channel) {
+		PolynomialFit const& fit = fits[channel];
+		ASSERT_EQ(3, fit.coefficients.size());
+		ASSERT_EQ(9, fit.covariance.size());
+		EXPECT_EQ(20, fit.points);
+		EXPECT_GT(fit.chisq, 0.);
+		EXPECT_NEAR(-(4e-4 + 1e-5 * channel), fit.coefficients[1], 1e-6);
+
+		// same as fitting a single channel
+		ADCCalibration single;
+		PolynomialFit const one = single.makePolynomialTrafo(channel, voltages[channel]);
+		EXPECT_EQ(fit.coefficients, one.coefficients);
+		EXPECT_EQ(fit.chisq, one.chisq);
+		EXPECT_EQ(*adc.at(channel), *single.at(channel));
+
+		// normal equations agree within rounding
+		PolynomialFit const other = normal.fit(voltages[channel], 2);
+		for (size_t ii = 0; ii < fit.coefficients.size(); ++ii) {
+			EXPECT_NEAR(fit.coefficients[ii], other.coefficients[ii],
+			            1e-7 * std::abs(fit.coefficients[ii]));
+		}
+		for (size_t ii = 0; ii < fit.covariance.size(); ++ii) {
+			EXPECT_NEAR(fit.covariance[ii], other.covariance[ii],
+			            1e-6 * std::abs(fit.covariance[ii]));
+		}
+		EXPECT_NEAR(fit.chisq, other.chisq, 1e-6 * fit.chisq);
+	}
+
+	// nothing is modified if a fit fails
+	voltages[3] = VoltageMeasurement();
+	ADCCalibration failed;
+	ASSERT_ANY_THROW(failed.makePolynomialTrafos(voltages));
+	ASSERT_FALSE(failed.exists(0));
+	ASSERT_ANY_THROW(adc.makePolynomialTrafos(std::vector<VoltageMeasurement>(7)));
 }
 
 TEST(Calibtic, GmaxConfig)
@@ -918,6 +1593,17 @@ TEST(SynapseRowCalibration, FindBestConfig)
 	ASSERT_EQ(c2, src.findBestGmaxConfig(max_required_weight_2));
 	ASSERT_EQ(c2, src.findBestGmaxConfig(max_required_weight_3));
 
+	// the cached order follows inserted and modified calibrations
+	shared_ptr<SynapseCalibration> s3(new SynapseCalibration);
+	s3->reset(0,Polynomial::create({0.5,1})); // y=0.5+x
+	GmaxConfig c3(2,1);
+	src.insert(c3,s3);
+	ASSERT_EQ(c3, src.findBestGmaxConfig(15.2));
+	src.at(c3)->reset(0,Polynomial::create({2,1})); // y=2+x
+	ASSERT_EQ(c3, src.findBestGmaxConfig(16.5));
+	ASSERT_EQ(1, src.erase(c3));
+	ASSERT_EQ(c2, src.findBestGmaxConfig(16.5));
+
 	src.clear();
 	ASSERT_EQ(c_default, src.findBestGmaxConfig(1.));
 	src.clear();
@@ -925,6 +1611,59 @@ TEST(SynapseRowCalibration, FindBestConfig)
 	ASSERT_EQ(c_default, src.findBestGmaxConfig(1.));
 }
 
+TEST(SynapseRowCalibration, FindBestConfigEss)
+{
+	using namespace HMF;
+	SynapseRowCalibration src;
+	src.setEssDefaults();
+
+	// the config with the smallest sufficient maximum weight, otherwise the
+	// one with the largest maximum weight
+	auto reference = [&src](double weight) {
+		GmaxConfig best(0, 0);
+		double best_sufficient = std::numeric_limits<double>::infinity();
+		double best_max = -std::numeric_limits<double>::infinity();
+		for (uint8_t sel = 0; sel < 4; ++sel) {
+			for (uint8_t div = 0; div < 16; ++div) {
+				GmaxConfig const config(sel, div);
+				if (!src.exists(config)) {
+					continue;
+				}
+				double const max = const_cast<SynapseRowCalibration const&>(src)
+				                       .at(config)->getMaxAnalogWeight();
+				if (weight <= max && max < best_sufficient) {
+					best_sufficient = max;
+					best = config;
+				}
+				if (best_sufficient == std::numeric_limits<double>::infinity() &&
+				    max > best_max) {
+					best_max = max;
+					best = config;
+				}
+			}
+		}
+		return best;
+	};
+
+	for (double weight = 0; weight < 2000; weight += 7.3) {
+		ASSERT_EQ(reference(weight), src.findBestGmaxConfig(weight)) << weight;
+	}
+
+	SynapseRowCollection collection;
+	collection.setEssDefaults();
+	std::vector<double> weights;
+	std::vector<size_t> rows;
+	for (size_t row = 0; row < collection.size(); ++row) {
+		weights.push_back(4.5 * row);
+		rows.push_back(row);
+	}
+	std::vector<GmaxConfig> configs(rows.size());
+	collection.findBestGmaxConfig(weights.data(), rows.data(), rows.size(), configs.data());
+	for (size_t ii = 0; ii < rows.size(); ++ii) {
+		ASSERT_EQ(reference(weights[ii]), configs[ii]) << weights[ii];
+	}
+}
+
 TEST(Calibtic, SynapseRowCollection)
 {
 	using namespace HMF;
@@ -1067,3 +1806,229 @@ TYPED_TEST(BasicTest, SynapseSwitchCollection)
 		ASSERT_EQ(254, ssc.getMaxSwitches(halco::hicann::v2::VLineOnHICANN(42)));
 	}
 }
+
+TYPED_TEST(BasicTest, MixedCollection)
+{
+	auto shared = Polynomial::create({1., 2., 3.}, -1., 5.);
+
+	shared_ptr<Calibration> cal(new Calibration(7));
+	cal->reset(0, Constant::create(4.2));
+	cal->reset(1, shared);
+	cal->reset(2, shared);
+	cal->reset(3, SumOfTrafos::create({shared, Constant::create(1.)}));
+	cal->reset(4, PowerOfTrafo::create(2., shared));
+	cal->reset(5, OneOverPolynomial::create({1., 2.}));
+
+	shared_ptr<HMF::HICANNCollection> hicann(new HMF::HICANNCollection);
+	hicann->setSpeedup(42);
+	shared_ptr<HMF::SynapseRowCalibration> row(new HMF::SynapseRowCalibration);
+	row->setDefaults();
+
+	Collection set0;
+	set0.insert(0, cal);
+	set0.insert(1, hicann);
+	set0.insert(2, row);
+	set0.insert(3, HMF::ADC::QuadraticADCCalibration::create());
+
+	MetaData md0(7, "author", "comment");
+	TestFixture::backend->store("mixed", md0, set0);
+
+	MetaData md1;
+	Collection set1;
+	TestFixture::backend->load("mixed", md1, set1);
+	ASSERT_EQ(set0.size(), set1.size());
+	for (int key : {0, 1, 3}) {
+		EXPECT_TRUE(*set0.at(key) == *set1.at(key)) << key;
+	}
+
+	EXPECT_EQ(md0.getID(), md1.getID());
+	EXPECT_EQ(md0.getAuthor(), md1.getAuthor());
+	EXPECT_EQ(md0.getComment(), md1.getComment());
+	EXPECT_EQ(md0.getCreatePOSIX(), md1.getCreatePOSIX());
+	EXPECT_EQ(md0.getModifyPOSIX(), md1.getModifyPOSIX());
+
+	auto loaded = boost::dynamic_pointer_cast<Calibration>(set1.at(0));
+	ASSERT_TRUE(static_cast<bool>(loaded));
+	EXPECT_FALSE(loaded->exists(6));
+	// shared transformations stay shared
+	EXPECT_EQ(loaded->at(1), loaded->at(2));
+	EXPECT_EQ(shared->getReverseDomain(), loaded->at(1)->getReverseDomain());
+	EXPECT_EQ(shared->apply(2.), loaded->at(4)->apply(2.) / shared->apply(2.));
+
+	auto loaded_hicann = boost::dynamic_pointer_cast<HMF::HICANNCollection>(set1.at(1));
+	ASSERT_TRUE(static_cast<bool>(loaded_hicann));
+	EXPECT_EQ(42, loaded_hicann->getSpeedup());
+
+	// SynapseRowCalibration::operator== compares pointers
+	auto loaded_row = boost::dynamic_pointer_cast<HMF::SynapseRowCalibration>(set1.at(2));
+	ASSERT_TRUE(static_cast<bool>(loaded_row));
+	ASSERT_EQ(row->size(), loaded_row->size());
+	EXPECT_TRUE(*row->at(HMF::GmaxConfig::Default()) ==
+	            *loaded_row->at(HMF::GmaxConfig::Default()));
+	EXPECT_TRUE(static_cast<bool>(
+		boost::dynamic_pointer_cast<HMF::ADC::QuadraticADCCalibration>(set1.at(3))));
+}
+
+TEST(Calibtic, CompressedBackend)
+{
+	auto const path = boost::filesystem::unique_path();
+	boost::filesystem::create_directories(path);
+
+	HMF::NeuronCollection set0;
+	set0.setDefaults();
+	set0.setSpeedup(1337);
+
+#ifdef CALIBTIC_HAVE_ZSTD
+	std::vector<std::string> const compressions = {"zstd", "gzip", "none"};
+#else
+	std::vector<std::string> const compressions = {"gzip", "none"};
+#endif
+	for (std::string const& compression : compressions) {
+		auto const writer = init_my_backend(XMLBackend::library());
+		writer->config("path", path.native());
+		writer->config("compression", compression);
+		writer->init();
+		writer->store("compressed", MetaData(3), set0);
+
+		std::ifstream file((path / "compressed.xml").native(), std::ios::binary);
+		char first = 0;
+		file.get(first);
+		EXPECT_EQ(compression == "none", first == '<') << compression;
+
+		// detected when reading
+		auto const reader = init_my_backend(XMLBackend::library());
+		reader->config("path", path.native());
+		reader->init();
+
+		MetaData md;
+		HMF::NeuronCollection set1;
+		reader->load("compressed", md, set1);
+		EXPECT_EQ(3, md.getID());
+		EXPECT_EQ(1337, set1.getSpeedup());
+		EXPECT_TRUE(set0 == set1) << compression;
+	}
+
+	auto const backend = init_my_backend(XMLBackend::library());
+	backend->config("compression", "rar");
+	EXPECT_THROW(backend->init(), std::runtime_error);
+#ifndef CALIBTIC_HAVE_ZSTD
+	backend->config("compression", "zstd");
+	EXPECT_THROW(backend->init(), std::runtime_error);
+#endif
+
+	// mapped files cannot be compressed
+	auto const mapped = init_my_backend(MmapBackend::library());
+	mapped->config("compression", "gzip");
+	EXPECT_THROW(mapped->init(), std::runtime_error);
+
+	boost::filesystem::remove_all(path);
+}
+
+TEST(Calibtic, HICANNCollectionSectionLoader)
+{
+	shared_ptr<HMF::NeuronCollection> stored(new HMF::NeuronCollection);
+	stored->setSpeedup(42);
+
+	size_t calls[6] = {};
+	HMF::HICANNCollection hc;
+	auto const placeholder = hc.at(0);
+	hc.setSectionLoader([&](Collection::key_type const key) -> shared_ptr<Base> {
+		++calls[key];
+		return key == 0 ? stored : shared_ptr<Base>();
+	});
+
+	// accessing the entry directly does not load it
+	EXPECT_EQ(0, calls[0]);
+	EXPECT_EQ(placeholder, hc.at(0));
+
+	EXPECT_EQ(42, hc.atNeuronCollection()->getSpeedup());
+	EXPECT_EQ(42, hc.atNeuronCollection()->getSpeedup());
+	EXPECT_EQ(1, calls[0]);
+	// filled in place
+	EXPECT_EQ(placeholder, hc.atNeuronCollection());
+	EXPECT_EQ(0, calls[1]);
+
+	// missing sections get their defaults
+	HMF::HICANNCollection const& chc = hc;
+	EXPECT_TRUE(chc.atBlockCollection()->exists(0));
+	EXPECT_EQ(1, calls[1]);
+
+	hc.loadSections();
+	for (size_t key = 0; key < 6; ++key) {
+		EXPECT_EQ(1, calls[key]) << key;
+	}
+}
+
+TEST(Calibtic, HICANNCollectionSectionLoaderKeepsReplaced)
+{
+	shared_ptr<HMF::NeuronCollection> stored(new HMF::NeuronCollection);
+	stored->setSpeedup(42);
+	size_t calls = 0;
+
+	HMF::HICANNCollection hc;
+	hc.setSectionLoader([&](Collection::key_type const key) -> shared_ptr<Base> {
+		++calls;
+		return key == 0 ? stored : shared_ptr<Base>();
+	});
+
+	// replaced before the first access, through the base class
+	shared_ptr<HMF::NeuronCollection> replaced(new HMF::NeuronCollection);
+	replaced->setSpeedup(23);
+	Collection& base = hc;
+	base.erase(0);
+	base.insert(0, replaced);
+
+	EXPECT_EQ(replaced, hc.atNeuronCollection());
+	EXPECT_EQ(23, replaced->getSpeedup());
+
+	EXPECT_EQ(0, calls);
+
+	// at() of the HICANNCollection loads as well
+	auto const block = hc.at(1);
+	EXPECT_EQ(1, calls);
+	EXPECT_TRUE(hc.atBlockCollection()->exists(0));
+	EXPECT_EQ(block, hc.atBlockCollection());
+}
+
+TEST(Calibtic, LazyHICANNCollection)
+{
+	auto const backend = init_my_backend(MmapBackend::library());
+	ASSERT_TRUE(static_cast<bool>(backend));
+
+	auto const path = boost::filesystem::unique_path();
+	boost::filesystem::create_directories(path);
+	backend->config("path", path.native());
+	backend->config("lazy", 1);
+	backend->init();
+
+	HMF::HICANNCollection hc0;
+	hc0.setDefaults();
+	hc0.setSpeedup(42);
+	hc0.atNeuronCollection()->setSpeedup(23);
+	hc0.erase(5);
+
+	MetaData md;
+	backend->store("lazy", md, hc0);
+
+	HMF::HICANNCollection hc1;
+	backend->load("lazy", md, hc1);
+	EXPECT_EQ(42, hc1.getSpeedup());
+	EXPECT_EQ(23, hc1.atNeuronCollection()->getSpeedup());
+	EXPECT_TRUE(hc1.atBlockCollection()->exists(0));
+	// not stored, defaults
+	EXPECT_TRUE(hc1.atSynapseSwitchCollection()->exists(0));
+
+	// storing a partially loaded collection stores all of it
+	backend->store("lazy2", md, hc1);
+	backend->config("lazy", 0);
+	HMF::HICANNCollection hc2;
+	backend->load("lazy2", md, hc2);
+	// SynapseRowCalibration::operator== compares pointers
+	EXPECT_EQ(hc1.keys(), hc2.keys());
+	EXPECT_TRUE(*hc1.atNeuronCollection() == *hc2.atNeuronCollection());
+	EXPECT_TRUE(*hc1.atBlockCollection() == *hc2.atBlockCollection());
+	EXPECT_TRUE(*hc1.atSynapseSwitchCollection() == *hc2.atSynapseSwitchCollection());
+	EXPECT_EQ(23, hc2.atNeuronCollection()->getSpeedup());
+
+	boost::filesystem::remove_all(path);
+}
@@ -145,7 +145,9 @@ class TestPyCalibtic(unittest.TestCase):
             if cc == c_gnd:
                 # skip GND "channel"
                 continue
-            adc.makePolynomialTrafo(cc.value(), vm)
+            fit = adc.makePolynomialTrafo(cc.value(), vm)
+            self.assertEqual(len(fit.coefficients), 3)
+            self.assertEqual(fit.points, vm.size())
 
         # convert raw data to voltages
         res = adc.apply(channel, data)
@@ -174,6 +176,37 @@ class TestPyCalibtic(unittest.TestCase):
             self.assertAlmostEqual(res[0], 0.21, places=2)
             self.assertGreater(res[1], res[2])
 
+            # convert into an existing array, which is written in place
+            out = np.zeros(4, dtype=np.float32)
+            adc.apply(channel, data, out)
+            np.testing.assert_array_equal(out[:3], res)
+            self.assertEqual(out[3], 0.)
+            self.assertRaises(RuntimeError, adc.apply, channel, data,
+                              np.zeros(2, dtype=np.float32))
+
+    def test_ADCTraceStatistics(self):
+        adc = cal.ADCCalibration.getDefaultCalibration()
+        channel = pyhalco_hicann_v2.ChannelOnADC(0)
+        data = np.arange(1000, 3000, 3, dtype=np.ushort)
+        voltages = np.array(adc.apply(channel, data), dtype=np.float64)
+
+        stats = adc.statistics(channel, data, cal.TraceStatistics(10, 0.6, 1.2))
+        self.assertEqual(stats.count(), len(data))
+        self.assertAlmostEqual(stats.mean(), voltages.mean(), places=9)
+        self.assertAlmostEqual(stats.variance(), voltages.var(), places=9)
+        self.assertAlmostEqual(stats.min(), voltages.min(), places=6)
+        self.assertAlmostEqual(stats.max(), voltages.max(), places=6)
+
+        self.assertEqual(sum(stats.histogram()) + stats.underflow() + stats.overflow(),
+                         len(data))
+        self.assertEqual(stats.underflow(), np.sum(voltages < 0.6))
+
+        # NaN is counted as overflow
+        overflow = stats.overflow()
+        stats.push(float('nan'))
+        self.assertEqual(stats.overflow(), overflow + 1)
+        self.assertTrue(np.isnan(stats.mean()))
+
     def test_HICANNCollection(self):
         """Write HICANNCollection to backend and read it back, compare"""
 
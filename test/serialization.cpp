@@ -104,6 +104,7 @@ typedef ::testing::Types<
 	, NeuronCalibration
 	, ADC::ADCCalibration
 	, ADC::QuadraticADCCalibration
+	, ADC::LUTADCCalibration
 > CalibrationTypes;
 
 template<typename T>
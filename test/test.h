@@ -31,19 +31,25 @@ random(T const max = std::numeric_limits<T>::max(),
 
 boost::shared_ptr<calibtic::backend::Backend> init_my_backend(std::string const& fname);
 
-template <typename T>
-class TestWithBackend : public ::testing::Test {};
-struct XMLBackend {};
+struct XMLBackend
+{
+	static char const* library() { return "libcalibtic_xml.so"; }
+};
 
-template<>
-class TestWithBackend<XMLBackend> : public ::testing::Test
+struct MmapBackend
+{
+	static char const* library() { return "libcalibtic_mmap.so"; }
+};
+
+template <typename T>
+class TestWithBackend : public ::testing::Test
 {
 public:
 	static void SetUpTestCase()
 	{
 		using namespace boost::filesystem;
 
-		backend = init_my_backend("libcalibtic_xml.so");
+		backend = init_my_backend(T::library());
 		ASSERT_TRUE(static_cast<bool>(backend));
 
 		backendPath = boost::filesystem::unique_path();
@@ -61,4 +67,10 @@ public:
 	static boost::shared_ptr<calibtic::backend::Backend> backend;
 	static boost::filesystem::path backendPath;
 };
-typedef ::testing::Types<XMLBackend> BackendTypes;
+
+template <typename T>
+boost::shared_ptr<calibtic::backend::Backend> TestWithBackend<T>::backend;
+template <typename T>
+boost::filesystem::path TestWithBackend<T>::backendPath;
+
+typedef ::testing::Types<XMLBackend, MmapBackend> BackendTypes;
@@ -3,16 +3,21 @@
 #include <sstream>
 #include <numeric>
 #include <cmath>
+#include <random>
 
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
 
 #include "calibtic/Collection.h"
 #include "calibtic/Calibration.h"
+#include "calibtic/simd.h"
 #include "calibtic/backend/Library.h"
 #include "calibtic/backend/Backend.h"
 #include "calibtic/trafo/Transformation.h"
 #include "calibtic/trafo/Polynomial.h"
+#include "calibtic/trafo/Program.h"
+#include "calibtic/trafo/Pool.h"
+#include "calibtic/trafo/Horner.h"
 #include "calibtic/trafo/SumOfTrafos.h"
 #include "calibtic/trafo/PowerOfTrafo.h"
 #include "calibtic/trafo/OneOverPolynomial.h"
@@ -395,3 +400,428 @@ TEST(Polynomial, FindRoots)
 		CHECK_FIND_ROOTS(60.0, 0, 100);
 	}
 }
+
+TEST(Polynomial, HornerKernels)
+{
+	std::mt19937 gen(1234);
+	std::uniform_real_distribution<float_type> coeff_dist(-10, 10);
+	std::uniform_real_distribution<float_type> value_dist(0.01, 5);
+
+	// odd sizes exercise the scalar remainder of the vector kernels
+	std::vector<float_type> in(1037);
+	for (auto& val : in) {
+		val = value_dist(gen);
+	}
+
+	for (size_t ncoeff = 0; ncoeff < 8; ++ncoeff) {
+		std::vector<float_type> coeff(ncoeff);
+		for (auto& c : coeff) {
+			c = coeff_dist(gen);
+		}
+
+		std::vector<float_type> ref(in.size());
+		std::vector<float_type> ref_negative(in.size());
+		horner::evaluate(coeff.data(), ncoeff, in.data(), ref.data(), in.size(),
+		                 simd::SCALAR);
+		horner::evaluate_negative_powers(coeff.data(), ncoeff, in.data(),
+		                                 ref_negative.data(), in.size(), simd::SCALAR);
+
+		for (size_t ii = 0; ii < in.size(); ++ii) {
+			ASSERT_EQ(horner::evaluate(coeff.data(), ncoeff, in[ii]), ref[ii]);
+			ASSERT_EQ(horner::evaluate_negative_powers(coeff.data(), ncoeff, in[ii]),
+			          ref_negative[ii]);
+		}
+
+		for (auto kernel : {simd::AVX2, simd::AVX512}) {
+			if (!simd::supported(kernel)) {
+				continue;
+			}
+
+			std::vector<float_type> out(in.size());
+			horner::evaluate(coeff.data(), ncoeff, in.data(), out.data(), in.size(),
+			                 kernel);
+			ASSERT_EQ(ref, out) << "kernel " << kernel << ", " << ncoeff << " coefficients";
+
+			std::vector<float_type> inplace(in);
+			horner::evaluate_negative_powers(coeff.data(), ncoeff, inplace.data(),
+			                                 inplace.data(), inplace.size(), kernel);
+			ASSERT_EQ(ref_negative, inplace) << "kernel " << kernel << ", " << ncoeff
+			                                 << " coefficients";
+		}
+	}
+
+	Polynomial const p({1, -2, 0.5, 3}, 0, 5);
+	std::vector<float_type> out(in.size());
+	p.apply(in.data(), out.data(), in.size());
+	for (size_t ii = 0; ii < in.size(); ++ii) {
+		ASSERT_EQ(p.apply(in[ii]), out[ii]);
+	}
+}
+
+TEST(Polynomial, InverseCache)
+{
+	std::vector<boost::shared_ptr<Transformation> > const trafos = {
+	    boost::make_shared<Polynomial>(Polynomial::data_type{1, 0.5}, 0, 50),
+	    boost::make_shared<Polynomial>(Polynomial::data_type{1, 2, 3}, 0, 50),
+	    boost::make_shared<Polynomial>(Polynomial::data_type{4, -0.3, -0.02, 0.001}, 0, 5),
+	    boost::make_shared<NegativePowersPolynomial>(Polynomial::data_type{1, 2, 3}, 0.1, 50),
+	    boost::make_shared<OneOverPolynomial>(Polynomial::data_type{1, 2, 3}, 0, 50)};
+
+	for (auto const& t : trafos) {
+		float_type const lower = t->getReverseDomain().lower();
+		float_type const upper = t->getReverseDomain().upper();
+
+		// the exact solver may miss roots on the domain boundaries
+		std::vector<float_type> in;
+		for (size_t ii = 1; ii < 1000; ++ii) {
+			in.push_back(lower + (upper - lower) * ii / 1000);
+		}
+
+		std::vector<float_type> cached(in.size());
+		t->reverseApply(in.data(), cached.data(), in.size(), Transformation::CLIP);
+
+		for (size_t ii = 0; ii < in.size(); ++ii) {
+			float_type const exact = t->reverseApply(in[ii], Transformation::CLIP);
+			ASSERT_EQ(exact, cached[ii]) << *t;
+		}
+
+		if (auto p = boost::dynamic_pointer_cast<Polynomial>(t)) {
+			p->setUseInverseCache(false);
+		} else {
+			boost::dynamic_pointer_cast<OneOverPolynomial>(t)->setUseInverseCache(false);
+		}
+
+		for (size_t ii = 0; ii < in.size(); ++ii) {
+			float_type const exact = t->reverseApply(in[ii], Transformation::CLIP);
+			ASSERT_NEAR(exact, cached[ii], 1e-12 * std::max(1., std::abs(exact))) << *t;
+		}
+	}
+
+	// not monotone on its domain, falls back to the exact solver
+	Polynomial p({0, 0, 1}, -1, 2);
+	ASSERT_NEAR(1.5, p.reverseApply(2.25), 1e-12);
+	ASSERT_THROW(p.reverseApply(0.25), OutsideDomainException);
+
+	// the cache follows changes of the coefficients and the domain
+	Polynomial q({1, 2}, 0, 10);
+	ASSERT_NEAR(2., q.reverseApply(5.), 1e-12);
+	q.getData()[1] = 4;
+	q.setDomain(0, 10);
+	ASSERT_NEAR(1., q.reverseApply(5.), 1e-12);
+	q.setDomain(2, 10);
+	ASSERT_THROW(q.reverseApply(5., Transformation::IGNORE), OutsideDomainException);
+}
+
+TEST(Polynomial, BrentRootFinder)
+{
+	std::vector<boost::shared_ptr<Transformation> > const trafos = {
+	    boost::make_shared<Polynomial>(Polynomial::data_type{1, 0.5}, 0, 50),
+	    boost::make_shared<Polynomial>(Polynomial::data_type{1, 2, 3}, 0, 50),
+	    boost::make_shared<Polynomial>(Polynomial::data_type{4, -0.3, -0.02, 0.001}, 0, 5),
+	    boost::make_shared<NegativePowersPolynomial>(Polynomial::data_type{1, 2, 3}, 0.1, 50),
+	    boost::make_shared<OneOverPolynomial>(Polynomial::data_type{1, 2, 3}, 0, 50)};
+
+	for (auto const& t : trafos) {
+		auto const p = boost::dynamic_pointer_cast<Polynomial>(t);
+		auto const o = boost::dynamic_pointer_cast<OneOverPolynomial>(t);
+
+		float_type const lower = t->getReverseDomain().lower();
+		float_type const upper = t->getReverseDomain().upper();
+
+		for (size_t ii = 1; ii < 1000; ++ii) {
+			float_type const val = lower + (upper - lower) * ii / 1000;
+
+			if (p) {
+				p->setUseInverseCache(false);
+				p->setRootFinder(Polynomial::COMPANION_MATRIX);
+			} else {
+				o->setUseInverseCache(false);
+				o->setRootFinder(Polynomial::COMPANION_MATRIX);
+			}
+			float_type const reference = t->reverseApply(val, Transformation::CLIP);
+
+			if (p) {
+				p->setRootFinder(Polynomial::BRENT);
+			} else {
+				o->setRootFinder(Polynomial::BRENT);
+			}
+			float_type const brent = t->reverseApply(val, Transformation::CLIP);
+
+			ASSERT_NEAR(reference, brent, 1e-12 * std::max(1., std::abs(reference))) << *t;
+		}
+	}
+
+	Polynomial p({0, 0, 1}, 1, 2);
+	p.setUseInverseCache(false);
+	p.setRootFinder(Polynomial::BRENT);
+	ASSERT_EQ(Polynomial::BRENT, p.getRootFinder());
+	ASSERT_NEAR(1.5, p.reverseApply(2.25), 1e-12);
+	ASSERT_EQ(2., p.reverseApply(4.));
+	ASSERT_THROW(p.reverseApply(0.25, Transformation::IGNORE), OutsideDomainException);
+
+	// the default domain is unbounded, solved by the companion matrix
+	for (bool cache : {false, true}) {
+		Polynomial q({1, 2, 3});
+		q.setUseInverseCache(cache);
+		q.setRootFinder(Polynomial::BRENT);
+		ASSERT_NEAR(1., q.reverseApply(6.), 1e-12);
+	}
+}
+
+TEST(Lookup, SearchModes)
+{
+	// 1/x shape of the shipped tables, linear and short tables in both directions
+	std::vector<Lookup::data_type> tables(4);
+	for (size_t ii = 0; ii < 1013; ++ii) {
+		tables[0].push_back(1e3 / (ii + 3.));
+		tables[1].push_back(0.25 * ii + 0.2 * std::sin(double(ii)));
+	}
+	tables[2] = Lookup::data_type(tables[1].rbegin(), tables[1].rend());
+	tables[3] = {1, 2, 2, 2, 3, 5, 8};
+
+	std::mt19937 gen(1234);
+
+	for (auto const& data : tables) {
+		Lookup lookup(data, 3);
+		float_type const lower = lookup.getDomain().lower();
+		float_type const upper = lookup.getDomain().upper();
+
+		std::vector<float_type> in;
+		std::uniform_real_distribution<float_type> dist(lower, upper);
+		for (size_t ii = 0; ii < 2000; ++ii) {
+			in.push_back(dist(gen));
+		}
+		// hit the entries exactly
+		in.insert(in.end(), data.begin(), data.end());
+
+		std::vector<float_type> reference(in.size());
+		bool const raising = data.front() < data.back();
+		for (size_t ii = 0; ii < in.size(); ++ii) {
+			auto const pos = raising
+			    ? std::lower_bound(data.begin(), data.end(), in[ii])
+			    : std::lower_bound(data.begin(), data.end(), in[ii],
+			                       std::greater_equal<float_type>());
+			reference[ii] = std::distance(data.begin(), pos) + 3 - 1;
+		}
+
+		std::vector<Lookup::search_mode> const modes = raising
+		    ? std::vector<Lookup::search_mode>{Lookup::SEARCH_BINARY_RAISING,
+		                                       Lookup::SEARCH_EYTZINGER_RAISING,
+		                                       Lookup::SEARCH_INTERPOLATION_RAISING}
+		    : std::vector<Lookup::search_mode>{Lookup::SEARCH_BINARY_FALLING,
+		                                       Lookup::SEARCH_EYTZINGER_FALLING,
+		                                       Lookup::SEARCH_INTERPOLATION_FALLING};
+
+		for (auto const mode : modes) {
+			lookup.setSearchMode(mode);
+			std::vector<float_type> out(in.size());
+			lookup.apply(in.data(), out.data(), in.size());
+			for (size_t ii = 0; ii < in.size(); ++ii) {
+				ASSERT_EQ(reference[ii], lookup.apply(in[ii])) << mode;
+				ASSERT_EQ(reference[ii], out[ii]) << mode;
+			}
+		}
+
+		ASSERT_THROW(lookup.setSearchMode(
+		    raising ? Lookup::SEARCH_BINARY_FALLING : Lookup::SEARCH_BINARY_RAISING),
+		    std::runtime_error);
+	}
+
+	ASSERT_EQ(Lookup::SEARCH_EYTZINGER_FALLING, Lookup(tables[0]).getSearchMode());
+	ASSERT_EQ(Lookup::SEARCH_INTERPOLATION_RAISING, Lookup(tables[1]).getSearchMode());
+	ASSERT_EQ(Lookup::SEARCH_INTERPOLATION_FALLING, Lookup(tables[2]).getSearchMode());
+	ASSERT_EQ(Lookup::SEARCH_BINARY_RAISING, Lookup(tables[3]).getSearchMode());
+
+	// the search layout is rebuilt after loading
+	boost::shared_ptr<Transformation> trafo0(new Lookup(tables[0], 3));
+	boost::shared_ptr<Transformation> trafo1;
+	std::stringstream stream;
+	{
+		boost::archive::xml_oarchive oa(stream);
+		oa << make_nvp("trafo", trafo0);
+	}
+	{
+		boost::archive::xml_iarchive ia(stream);
+		ia >> make_nvp("trafo", trafo1);
+	}
+	ASSERT_EQ(*trafo0, *trafo1);
+	ASSERT_EQ(Lookup::SEARCH_EYTZINGER_FALLING,
+	          boost::dynamic_pointer_cast<Lookup>(trafo1)->getSearchMode());
+	for (float_type val = 1.; val < 300.; val += 0.37) {
+		ASSERT_EQ(trafo0->apply(val), trafo1->apply(val));
+	}
+}
+
+TEST(Program, SameResultAsTransformation)
+{
+	typedef boost::shared_ptr<Transformation> ptr;
+
+	ptr const poly = boost::make_shared<Polynomial>(Polynomial::data_type{0.1, 2, -0.3}, 0, 3);
+	ptr const npp = boost::make_shared<NegativePowersPolynomial>(Polynomial::data_type{1, 0.5, 0.25}, 0.5, 4);
+	ptr const lookup = boost::make_shared<Lookup>(Lookup::data_type{0, 0.5, 1, 2, 4}, 0);
+	ptr const inner_sum = boost::make_shared<SumOfTrafos>(
+	    SumOfTrafos::trafo_list{npp, boost::make_shared<Constant>(0.7), lookup}, 0.2, 3.5);
+	ptr const power = boost::make_shared<PowerOfTrafo>(1.5, inner_sum, 0, 3);
+
+	std::vector<ptr> const trafos = {
+	    boost::make_shared<SumOfTrafos>(SumOfTrafos::trafo_list{poly, power}, -1, 5),
+	    boost::make_shared<PowerOfTrafo>(2., boost::make_shared<SumOfTrafos>(
+	        SumOfTrafos::trafo_list{poly, poly, power}), 0, 3),
+	    boost::make_shared<PowerOfTrafo>(0.5, ptr(), 0, 10),
+	    boost::make_shared<SumOfTrafos>(SumOfTrafos::trafo_list{}, 0, 1),
+	    poly, npp, lookup, boost::make_shared<Constant>(4.2)};
+
+	std::vector<float_type> in;
+	for (float_type val = -2; val < 6; val += 0.01) {
+		in.push_back(val);
+	}
+	std::vector<float_type> expected(in.size()), out(in.size());
+
+	for (auto const& t : trafos) {
+		Program const program(t);
+
+		for (size_t ii = 0; ii < in.size(); ++ii) {
+			ASSERT_EQ(t->apply(in[ii], Transformation::CLIP),
+			          program.apply(in[ii])) << *t << program;
+			float_type const ignored = t->apply(in[ii], Transformation::IGNORE);
+			if (!std::isnan(ignored)) {
+				ASSERT_EQ(ignored, program.apply(in[ii], Transformation::IGNORE)) << *t << program;
+			} else {
+				ASSERT_TRUE(std::isnan(program.apply(in[ii], Transformation::IGNORE)));
+			}
+		}
+
+		t->apply(in.data(), expected.data(), in.size(), Transformation::CLIP);
+		program.apply(in.data(), out.data(), in.size());
+		ASSERT_EQ(expected, out) << *t << program;
+		for (size_t ii = 0; ii < in.size(); ++ii) {
+			ASSERT_EQ(t->apply(in[ii], Transformation::CLIP), expected[ii]) << *t;
+		}
+
+		if (!boost::dynamic_pointer_cast<Constant>(t)) {
+			ASSERT_THROW(program.apply(in.data(), out.data(), in.size(), Transformation::THROW),
+			             OutsideDomainException);
+		}
+	}
+
+	// composite trafos are flattened, the Lookup is called
+	Program const program(trafos[0]);
+	ASSERT_EQ(24u, program.size()) << program;
+
+	// coefficients are read when the program runs
+	boost::dynamic_pointer_cast<Polynomial>(poly)->getData()[0] = 1.1;
+	ASSERT_EQ(trafos[0]->apply(1.3), program.apply(1.3));
+
+	// NegativePowersPolynomial checks inputs of 0, also inside of a composite
+	ptr const npp_zero = boost::make_shared<NegativePowersPolynomial>(Polynomial::data_type{1, 0.5}, -1, 1);
+	std::vector<float_type> const with_zero = {0.5, 0., 1.};
+	for (auto const& t : {npp_zero, ptr(boost::make_shared<SumOfTrafos>(
+	                                      SumOfTrafos::trafo_list{poly, npp_zero}, -1, 1))}) {
+		Program const zero(t);
+
+		bool throws = false;
+		std::vector<float_type> single;
+		for (float_type const val : with_zero) {
+			try {
+				single.push_back(t->apply(val));
+			} catch (std::runtime_error const&) {
+				throws = true;
+				ASSERT_THROW(zero.apply(val), std::runtime_error) << zero;
+				continue;
+			}
+			ASSERT_EQ(single.back(), zero.apply(val)) << zero;
+		}
+
+		std::vector<float_type> batch(with_zero.size());
+		if (throws) {
+			ASSERT_THROW(zero.apply(with_zero.data(), batch.data(), batch.size()),
+			             std::runtime_error) << zero;
+		} else {
+			zero.apply(with_zero.data(), batch.data(), batch.size());
+			ASSERT_EQ(single, batch) << zero;
+		}
+	}
+
+	// the batch apply of composites keeps its program, copies and loaded
+	// objects compile their own
+	std::vector<float_type> const values = {0.5, 1., 2.5};
+	std::vector<float_type> batch(values.size());
+	PowerOfTrafo loaded(3., poly, 0, 3);
+	loaded.apply(values.data(), batch.data(), batch.size());
+	{
+		PowerOfTrafo const original(2., poly, 0, 3);
+		original.apply(values.data(), batch.data(), batch.size());
+		PowerOfTrafo const copy(original);
+		loaded = original;
+		copy.apply(values.data(), batch.data(), batch.size());
+		for (size_t ii = 0; ii < values.size(); ++ii) {
+			ASSERT_EQ(copy.apply(values[ii]), batch[ii]);
+		}
+	}
+	loaded.apply(values.data(), batch.data(), batch.size());
+	ASSERT_EQ(std::pow(poly->apply(values[0]), 2.), batch[0]);
+
+	std::stringstream stream;
+	{
+		PowerOfTrafo const cube(3., poly, 0, 3);
+		boost::archive::xml_oarchive oa(stream);
+		oa << make_nvp("trafo", cube);
+	}
+	{
+		boost::archive::xml_iarchive ia(stream);
+		ia >> make_nvp("trafo", loaded);
+	}
+	loaded.apply(values.data(), batch.data(), batch.size());
+	ASSERT_EQ(std::pow(poly->apply(values[0]), 3.), batch[0]);
+}
+
+TEST(Pool, Intern)
+{
+	// every calibration holds its own copy, e.g. after deserialization
+	auto make_calibration = []() {
+		boost::shared_ptr<Calibration> calib(new Calibration(4));
+		calib->reset(0, Constant::create(1023));
+		calib->reset(1, boost::make_shared<Polynomial>(Polynomial::data_type{0, 1023 / 1.8}, 0, 1.8));
+		calib->reset(2, boost::make_shared<Polynomial>(Polynomial::data_type{0, 1023 / 1.8}, 0, 1.0));
+		return calib;
+	};
+
+	Collection collection;
+	for (int ii = 0; ii < 10; ++ii) {
+		collection.insert(ii, make_calibration());
+	}
+
+	boost::shared_ptr<Calibration const> first =
+	    boost::dynamic_pointer_cast<Calibration const>(collection.at(0));
+	ASSERT_EQ(first->at(1)->hash(),
+	          boost::dynamic_pointer_cast<Calibration const>(collection.at(1))->at(1)->hash());
+
+	Pool pool;
+	collection.intern(pool);
+
+	// one instance per distinct transformation, the domain is distinguished
+	ASSERT_EQ(3u, pool.size());
+	ASSERT_NE(first->at(1), first->at(2));
+	ASSERT_FALSE(first->exists(3));
+	for (int ii = 1; ii < 10; ++ii) {
+		auto const calib = boost::dynamic_pointer_cast<Calibration const>(collection.at(ii));
+		for (size_t key = 0; key < 3; ++key) {
+			ASSERT_EQ(first->at(key), calib->at(key));
+		}
+	}
+
+	// sums with equal summands but different domains stay separate
+	Pool::trafo_ptr const p = boost::make_shared<Polynomial>(Polynomial::data_type{1, 2}, 0, 3);
+	Pool::trafo_ptr const sum1 = boost::make_shared<SumOfTrafos>(SumOfTrafos::trafo_list{p}, 0, 1);
+	Pool::trafo_ptr const sum2 = boost::make_shared<SumOfTrafos>(SumOfTrafos::trafo_list{p}, 0, 2);
+	Pool::trafo_ptr const sum3 = boost::make_shared<SumOfTrafos>(SumOfTrafos::trafo_list{p}, 0, 1);
+	ASSERT_EQ(sum1, pool.intern(sum1));
+	ASSERT_EQ(sum2, pool.intern(sum2));
+	ASSERT_EQ(sum1, pool.intern(sum3));
+	ASSERT_EQ(Pool::trafo_ptr(), pool.intern(Pool::trafo_ptr()));
+
+	// the pool does not keep instances alive
+	collection = Collection();
+	first.reset();
+	ASSERT_EQ(2u, pool.size());
+}
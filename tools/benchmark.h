@@ -0,0 +1,38 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <string>
+
+#include <boost/accumulators/accumulators.hpp>
+#include <boost/accumulators/statistics/stats.hpp>
+#include <boost/accumulators/statistics/min.hpp>
+#include <boost/accumulators/statistics/mean.hpp>
+
+namespace calibtic {
+namespace tools {
+
+/// calls @param run @param repeat times and prints the fastest and the
+/// average duration
+inline void benchmark(std::string const& name, std::function<void()> const& run,
+                      size_t const repeat)
+{
+	using namespace boost::accumulators;
+	accumulator_set<double, stats<tag::mean, tag::min>> acc;
+
+	std::cout << "Testing " << name << ": " << std::endl;
+	for (size_t ii = 0; ii < repeat; ++ii)
+	{
+		auto t1=std::chrono::high_resolution_clock::now();
+		run();
+		auto t2 = std::chrono::high_resolution_clock::now();
+		acc(std::chrono::duration_cast<std::chrono::microseconds>(t2-t1).count() / 1000.);
+	}
+	std::cout << "    fastest: " << min(acc) << "ms\n";
+	std::cout << "    average: " << mean(acc) << "ms" << std::endl;
+}
+
+} // tools
+} // calibtic
@@ -1,23 +1,50 @@
 #include <algorithm>
-#include <chrono>
 #include <iostream>
 #include <functional>
 #include <random>
-
-#include <boost/accumulators/accumulators.hpp>
-#include <boost/accumulators/statistics/stats.hpp>
-#include <boost/accumulators/statistics/min.hpp>
-#include <boost/accumulators/statistics/mean.hpp>
+#include <string>
 
 #include "calibtic/HMF/ADC/ADCCalibration.h"
 #include "calibtic/HMF/ADC/QuadraticADCCalibration.h"
+#include "calibtic/HMF/ADC/LUTADCCalibration.h"
+#include "calibtic/simd.h"
 #include "calibtic/trafo/Polynomial.h"
 
+#include "benchmark.h"
+
 using namespace HMF::ADC;
 
+namespace {
+
+const size_t repeat = 10;
+
+void benchmark(std::string const& name, std::function<void()> const& run,
+               std::vector<float> const& result)
+{
+	calibtic::tools::benchmark(name, run, repeat);
+	std::cout << "    first values:";
+	for (size_t ii = 0; ii < 5; ++ii) {
+		std::cout << " " << result[ii];
+	}
+	std::cout << " ..." << std::endl;
+}
+
+char const* kernel_name(calibtic::simd::Kernel kernel)
+{
+	switch (kernel) {
+		case calibtic::simd::AVX512:
+			return "avx512";
+		case calibtic::simd::AVX2:
+			return "avx2";
+		default:
+			return "scalar";
+	}
+}
+
+} // namespace
+
 int main()
 {
-	const size_t repeat = 10;
 	std::vector<uint16_t> data(2000000);
 	std::generate(data.begin(), data.end(), std::bind(
 		std::uniform_int_distribution<int>(0, 4095),
@@ -31,48 +58,40 @@ int main()
 	boost::shared_ptr<QuadraticADCCalibration> quadratic(
 		ADCCalibration::convertToQuadraticADCCalibration(*regular));
 
-	{
-		using namespace boost::accumulators;
-		accumulator_set<double, stats<tag::mean, tag::min>> acc;
-
-		std::vector<float> result;
-		std::cout << "Testing ADCCalibration: " << std::endl;
-		for (size_t ii = 0; ii < repeat; ++ii)
-		{
-			auto t1=std::chrono::high_resolution_clock::now();
-			result = regular->apply(channel, data);
-			auto t2 = std::chrono::high_resolution_clock::now();
-			acc(std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count());
-		}
-		std::cout << "    fastest: " << min(acc) << "ms\n";
-		std::cout << "    average: " << mean(acc) << "ms\n";
-		std::cout << "    first values:";
-		for (size_t ii = 0; ii < 5; ++ii) {
-			std::cout << " " << result[ii];
-		}
-		std::cout << " ..." << std::endl;
-	}
+	std::vector<float> result;
+	benchmark("ADCCalibration", [&] {
+		result = regular->apply(channel, data);
+	}, result);
+
+	benchmark("QuadraticADCCalibration", [&] {
+		result = quadratic->apply(channel, data);
+	}, result);
 
-	{
-		std::vector<float> result;
-		using namespace boost::accumulators;
-		accumulator_set<double, stats<tag::mean, tag::min>> acc;
-
-		std::cout << "Testing QuadraticADCCalibration: " << std::endl;
-		for (size_t ii = 0; ii < repeat; ++ii)
-		{
-			auto t1=std::chrono::high_resolution_clock::now();
-			result = quadratic->apply(channel, data);
-			auto t2 = std::chrono::high_resolution_clock::now();
-			acc(std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count());
+	// caller provided buffer, nothing is allocated per trace
+	std::vector<float> const reference = result;
+	std::vector<float> buffer(data.size());
+	for (auto kernel : {calibtic::simd::SCALAR, calibtic::simd::AVX2, calibtic::simd::AVX512}) {
+		if (!calibtic::simd::supported(kernel)) {
+			std::cout << "Skipping QuadraticADCCalibration (buffer, "
+			          << kernel_name(kernel) << "): not supported by this cpu" << std::endl;
+			continue;
 		}
-		std::cout << "    fastest: " << min(acc) << "ms\n";
-		std::cout << "    average: " << mean(acc) << "ms\n";
-		std::cout << "    first values:";
-		for (size_t ii = 0; ii < 5; ++ii) {
-			std::cout << " " << result[ii];
+
+		benchmark(std::string("QuadraticADCCalibration (buffer, ") + kernel_name(kernel) + ")", [&] {
+			quadratic->apply(channel, data.data(), buffer.data(), data.size(), kernel);
+		}, buffer);
+
+		if (buffer != reference) {
+			std::cout << "    MISMATCH with QuadraticADCCalibration" << std::endl;
+			return 1;
 		}
-		std::cout << " ..." << std::endl;
 	}
-}
 
+	boost::shared_ptr<LUTADCCalibration> lut(
+		ADCCalibration::convertToLUTADCCalibration(*regular));
+	benchmark("LUTADCCalibration (buffer)", [&] {
+		lut->apply(channel, data.data(), buffer.data(), data.size());
+	}, buffer);
+
+	std::cout << "Default kernel: " << kernel_name(calibtic::simd::best()) << std::endl;
+}
@@ -0,0 +1,55 @@
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "calibtic/backend/Backend.h"
+#include "calibtic/backend/Library.h"
+#include "calibtic/HMF/HICANNCollection.h"
+#include "calibtic/MetaData.h"
+
+#include "benchmark.h"
+
+using namespace calibtic;
+
+namespace {
+
+const size_t repeat = 100;
+
+} // namespace
+
+// stores a default HICANNCollection with each backend and measures loading it
+// again, the backends are given by name, e.g. "binary mmap"
+int main(int argc, char* argv[])
+{
+	std::vector<std::string> names(argv + 1, argv + argc);
+	if (names.empty()) {
+		names = {"xml", "text", "binary", "mmap"};
+	}
+
+	HMF::HICANNCollection hc;
+	hc.setDefaults();
+
+	boost::filesystem::path const path = boost::filesystem::temp_directory_path() /
+		boost::filesystem::unique_path();
+	boost::filesystem::create_directories(path);
+
+	for (auto const& name : names) {
+		auto lib = backend::loadLibrary("libcalibtic_" + name + ".so");
+		auto backend = backend::loadBackend(lib);
+		backend->config("path", path.native());
+		backend->init();
+		backend->store("hicann", MetaData(), hc);
+
+		tools::benchmark(name + " (store)", [&] {
+			backend->store("hicann", MetaData(), hc);
+		}, repeat);
+		tools::benchmark(name + " (load)", [&] {
+			MetaData md;
+			HMF::HICANNCollection loaded;
+			backend->load("hicann", md, loaded);
+		}, repeat);
+	}
+
+	boost::filesystem::remove_all(path);
+}